@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <effolkronium/random.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cube/Chunk.hpp>
+#include <cube/ColumnGenerator.hpp>
+#include <cube/DepthRasterizer.hpp>
+#include <cube/TerrainGenerator.hpp>
+#include <cube/TreeGenerator.hpp>
+
+
+using Random = effolkronium::random_static;
+using Clock = std::chrono::steady_clock;
+
+
+/** Minimum duration of a repetition, the number of iterations is scaled to reach it. */
+static constexpr GLdouble MIN_REPETITION_MS = 50.;
+/** Number of repetitions of each kernel, the median is reported. */
+static constexpr GLuint REPETITIONS = 5;
+/** Number of superchunks generated to time each generation stage. */
+static constexpr GLuint STAGE_SAMPLES = 16;
+
+
+
+struct Result {
+    std::string name;
+    GLuint64 iterations;
+    GLdouble median; /**< Median of the repetitions, in nanoseconds per iteration. */
+    GLdouble min;    /**< Fastest repetition, in nanoseconds per iteration. */
+};
+
+
+
+/**
+ * Prevent the compiler from optimizing away the computation of `value`.
+ */
+template<typename T>
+static void keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+
+static GLdouble elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<GLdouble, std::nano>(Clock::now() - start).count();
+}
+
+
+static Result summarize(const std::string &name, GLuint64 iterations, std::vector<GLdouble> samples) {
+    std::sort(samples.begin(), samples.end());
+    return { name, iterations, samples[samples.size() / 2], samples.front() };
+}
+
+
+/**
+ * Run `kernel(i)` in batches large enough to last `MIN_REPETITION_MS`, `REPETITIONS` times.
+ */
+static Result measure(const std::string &name, const std::function<void(GLuint64)> &kernel) {
+    std::vector<GLdouble> samples;
+    GLuint64 iterations = 1;
+    GLdouble ns;
+    
+    // Calibrate the number of iterations, also warming up caches
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (GLuint64 i = 0; i < iterations; i++) {
+            kernel(i);
+        }
+        ns = elapsedNs(start);
+        if (ns >= MIN_REPETITION_MS * 1e6) {
+            break;
+        }
+        iterations = ns < 1e3 ? iterations * 10 : static_cast<GLuint64>(
+            std::ceil(static_cast<GLdouble>(iterations) * MIN_REPETITION_MS * 1e6 / ns * 1.1)
+        );
+    }
+    
+    for (GLuint r = 0; r < REPETITIONS; r++) {
+        Clock::time_point start = Clock::now();
+        for (GLuint64 i = 0; i < iterations; i++) {
+            kernel(i);
+        }
+        samples.push_back(elapsedNs(start) / static_cast<GLdouble>(iterations));
+    }
+    
+    return summarize(name, iterations, samples);
+}
+
+
+
+/**
+ * Chunk tiling the space, so that cubes on its border have neighbours without any superchunk.
+ */
+class TiledChunk : public cube::IVoxelSource {
+    public:
+        cube::Chunk chunk;
+        
+        [[nodiscard]] cube::CubeData get(const glm::ivec3 &position) const override {
+            return this->chunk.get(
+                static_cast<GLubyte>(position.x & (cube::Chunk::X - 1)),
+                static_cast<GLubyte>(position.y & (cube::Chunk::Y - 1)),
+                static_cast<GLubyte>(position.z & (cube::Chunk::Z - 1))
+            );
+        }
+        
+        
+        void fill(const std::function<cube::CubeData(GLint, GLint, GLint)> &type) {
+            for (GLint x = 0; x < cube::Chunk::X; x++) {
+                for (GLint y = 0; y < cube::Chunk::Y; y++) {
+                    for (GLint z = 0; z < cube::Chunk::Z; z++) {
+                        this->chunk.set(
+                            static_cast<GLubyte>(x), static_cast<GLubyte>(y), static_cast<GLubyte>(z),
+                            type(x, y, z)
+                        );
+                    }
+                }
+            }
+        }
+};
+
+
+static void benchNoise(std::vector<Result> &results) {
+    for (GLubyte octaves = 1; octaves <= 8; octaves++) {
+        cube::Noise2D noise2D = cube::Noise2D({ 1234.f, 5678.f }, octaves, 1.f, 1 / 256.f, 0.5f, 2.f);
+        cube::Noise3D noise3D = cube::Noise3D({ 1234.f, 5678.f, 9012.f }, octaves, 1.f, 1 / 64.f, 0.5f, 2.f);
+        
+        results.push_back(measure(
+            "noise2d/octaves:" + std::to_string(octaves),
+            [&noise2D](GLuint64 i) {
+                keep(noise2D({ static_cast<GLfloat>(i & 1023), static_cast<GLfloat>(i >> 10) }));
+            }
+        ));
+        results.push_back(measure(
+            "noise3d/octaves:" + std::to_string(octaves),
+            [&noise3D](GLuint64 i) {
+                keep(noise3D({
+                    static_cast<GLfloat>(i & 63), static_cast<GLfloat>((i >> 6) & 63), static_cast<GLfloat>(i >> 12)
+                }));
+            }
+        ));
+    }
+}
+
+
+static void benchColumns(std::vector<Result> &results) {
+    static const std::pair<const char *, cube::CubeData> COLUMNS[] = {
+        { "water", cube::WATER },
+        { "ice", cube::ICE },
+        { "sand_beach", cube::SAND_BEACH },
+        { "sand_desert", cube::SAND_DESERT },
+        { "snow", cube::SNOW },
+        { "stone", cube::STONE },
+        { "stone_snow", cube::STONE_SNOW },
+        { "dirt_plain", cube::DIRT_PLAIN },
+        { "dirt_jungle", cube::DIRT_JUNGLE },
+        { "dirt_snow", cube::DIRT_SNOW },
+    };
+    
+    for (const auto &column : COLUMNS) {
+        cube::CubeData type = column.second;
+        results.push_back(measure(
+            std::string("column/") + column.first,
+            [type](GLuint64 i) {
+                keep(cube::ColumnGenerator::generate(
+                    cube::TerrainGenerator::MIN_H + static_cast<GLuint>(i % cube::TerrainGenerator::INTERVAL_H), type
+                ));
+            }
+        ));
+    }
+}
+
+
+static void benchTrees(std::vector<Result> &results) {
+    static const std::pair<const char *, cube::CubeData> BIOMES[] = {
+        { "dirt_plain", cube::DIRT_PLAIN },
+        { "dirt_jungle", cube::DIRT_JUNGLE },
+        { "dirt_snow", cube::DIRT_SNOW },
+        { "sand_desert", cube::SAND_DESERT },
+    };
+    
+    // Trees are randomly planted, the measure includes the draws that do not plant any tree
+    for (const auto &biome : BIOMES) {
+        cube::CubeData type = biome.second;
+        results.push_back(measure(
+            std::string("tree/") + biome.first,
+            [type](GLuint64) {
+                keep(cube::TreeGenerator::generate({ 32, cube::TerrainGenerator::MAX_H - 32, 32 }, type));
+            }
+        ));
+    }
+}
+
+
+static void benchGeneration(std::vector<Result> &results) {
+    cube::TerrainGenerator generator;
+    std::vector<GLdouble> shape, carve, paint, plant, total;
+    Clock::time_point start, stage;
+    
+    for (GLuint i = 0; i < STAGE_SAMPLES; i++) {
+        glm::ivec3 position = glm::ivec3(
+            static_cast<GLint>(i % 4) * cube::SuperChunk::X, 0, static_cast<GLint>(i / 4) * cube::SuperChunk::Z
+        );
+        std::unique_ptr<cube::SuperChunk> chunk = std::make_unique<cube::SuperChunk>(position);
+        
+        start = stage = Clock::now();
+        generator.shape(*chunk);
+        shape.push_back(elapsedNs(stage));
+        stage = Clock::now();
+        generator.carve(*chunk);
+        carve.push_back(elapsedNs(stage));
+        stage = Clock::now();
+        generator.paint(*chunk);
+        paint.push_back(elapsedNs(stage));
+        stage = Clock::now();
+        cube::TerrainGenerator::plant(*chunk);
+        plant.push_back(elapsedNs(stage));
+        total.push_back(elapsedNs(start));
+        keep(*chunk);
+    }
+    
+    results.push_back(summarize("superchunk/shape", STAGE_SAMPLES, shape));
+    results.push_back(summarize("superchunk/carve", STAGE_SAMPLES, carve));
+    results.push_back(summarize("superchunk/paint", STAGE_SAMPLES, paint));
+    results.push_back(summarize("superchunk/plant", STAGE_SAMPLES, plant));
+    results.push_back(summarize("superchunk/total", STAGE_SAMPLES, total));
+}
+
+
+static void benchMeshing(std::vector<Result> &results) {
+    cube::Noise3D caves = cube::Noise3D({ 4321.f, 8765.f, 2109.f }, 3, 1.f, 1 / 8.f, 0.5f, 2.f);
+    std::vector<std::pair<std::string, std::function<cube::CubeData(GLint, GLint, GLint)>>> chunks = {
+        {
+            "surface", [](GLint x, GLint y, GLint z) {
+                GLint height = 8 + static_cast<GLint>(3.f * std::sin(x * 0.4f) * std::cos(z * 0.3f));
+                if (y > height) {
+                    return (y == height + 1 && (x * 7 + z * 3) % 11 == 0) ? cube::FLOWERS : cube::AIR;
+                }
+                return y == height ? cube::DIRT_PLAIN : cube::STONE;
+            }
+        },
+        {
+            "cave", [&caves](GLint x, GLint y, GLint z) {
+                return caves(glm::vec3(x, y, z)) > 0.f ? cube::AIR : cube::STONE;
+            }
+        },
+        {
+            "ocean", [](GLint, GLint y, GLint) {
+                return y < 4 ? cube::SAND_BEACH : y < 12 ? cube::WATER : cube::AIR;
+            }
+        },
+        { "stone", [](GLint, GLint, GLint) { return cube::STONE; } },
+        { "air", [](GLint, GLint, GLint) { return cube::AIR; } },
+    };
+    
+    for (const auto &entry : chunks) {
+        auto tiled = std::make_unique<TiledChunk>();
+        tiled->fill(entry.second);
+        results.push_back(measure(
+            "mesh/" + entry.first,
+            [&tiled](GLuint64) {
+                tiled->chunk.touch();
+                keep(tiled->chunk.update(*tiled, true));
+            }
+        ));
+    }
+}
+
+
+static void benchRaster(std::vector<Result> &results) {
+    constexpr GLint RADIUS = 2; // Superchunks drawing occluders on each side of the camera, as in game
+    constexpr GLint CELLS = (2 * RADIUS + 1) * cube::SuperChunk::OCCLUDER_X;
+    auto rasterizer = std::make_unique<cube::DepthRasterizer>();
+    std::vector<std::pair<glm::vec3, glm::vec3>> occluders, chunks;
+    
+    // Rolling hills around a camera standing in a valley, looking along them
+    for (GLint x = 0; x < CELLS; x++) {
+        for (GLint z = 0; z < CELLS; z++) {
+            glm::vec3 min = glm::vec3(x, 0, z) * static_cast<GLfloat>(cube::SuperChunk::OCCLUDER_SIZE);
+            GLfloat height = 64.f + 24.f * std::sin(x * 0.5f) * std::cos(z * 0.3f);
+            occluders.emplace_back(min, min + glm::vec3(cube::SuperChunk::OCCLUDER_SIZE, height, cube::SuperChunk::OCCLUDER_SIZE));
+        }
+    }
+    for (GLint x = 0; x < CELLS / 2; x++) {
+        for (GLint y = 0; y < cube::SuperChunk::CHUNK_Y; y++) {
+            for (GLint z = 0; z < CELLS / 2; z++) {
+                glm::vec3 min = glm::vec3(x * cube::Chunk::X, y * cube::Chunk::Y, z * cube::Chunk::Z);
+                chunks.emplace_back(min, min + glm::vec3(cube::Chunk::X, cube::Chunk::Y, cube::Chunk::Z));
+            }
+        }
+    }
+    
+    glm::vec3 eye = glm::vec3(CELLS * cube::SuperChunk::OCCLUDER_SIZE / 2.f, 90.f, 8.f);
+    glm::mat4 viewProjection = glm::perspective(glm::radians(70.f), 16.f / 9.f, 0.1f, 1000.f)
+                               * glm::lookAt(eye, eye + glm::vec3(0.3f, -0.2f, 1.f), glm::vec3(0, 1, 0));
+    
+    results.push_back(measure(
+        "raster/occluders",
+        [&](GLuint64) {
+            rasterizer->clear(viewProjection);
+            for (const auto &box : occluders) {
+                rasterizer->drawBox(box.first, box.second);
+            }
+        }
+    ));
+    results.push_back(measure(
+        "raster/test",
+        [&](GLuint64) {
+            GLuint visible = 0;
+            for (const auto &box : chunks) {
+                visible += rasterizer->isVisible(box.first, box.second);
+            }
+            keep(visible);
+        }
+    ));
+}
+
+
+static void usage(const char *name) {
+    std::cerr << "Usage: " << name << " [OPTIONS]\n\n"
+              << "Options:\n"
+              << "  --seed N            Seed of the generator (default: 0).\n"
+              << "  --filter PREFIX     Only run the kernels whose name starts with PREFIX.\n"
+              << "  --output FILE       Also write the JSON report to FILE.\n";
+}
+
+
+int main(int argc, char **argv) {
+    std::vector<Result> results;
+    std::string filter, output, option;
+    GLuint seed = 0;
+    
+    try {
+        for (int i = 1; i < argc; i++) {
+            option = argv[i];
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(option);
+            }
+            if (option == "--seed") {
+                seed = static_cast<GLuint>(std::stoul(argv[++i]));
+            }
+            else if (option == "--filter") {
+                filter = argv[++i];
+            }
+            else if (option == "--output") {
+                output = argv[++i];
+            }
+            else {
+                throw std::invalid_argument(option);
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Error: Invalid option '" << option << "'\n" << std::endl;
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    Random::seed(seed);
+    
+    const std::pair<const char *, void (*)(std::vector<Result> &)> SUITES[] = {
+        { "noise", benchNoise },
+        { "column", benchColumns },
+        { "tree", benchTrees },
+        { "superchunk", benchGeneration },
+        { "mesh", benchMeshing },
+        { "raster", benchRaster },
+    };
+    for (const auto &suite : SUITES) {
+        std::string name = suite.first;
+        if (name.rfind(filter, 0) == 0 || filter.rfind(name, 0) == 0) {
+            std::cerr << "Running " << suite.first << "..." << std::endl;
+            suite.second(results);
+        }
+    }
+    results.erase(
+        std::remove_if(
+            results.begin(), results.end(),
+            [&filter](const Result &r) { return r.name.rfind(filter, 0) != 0; }
+        ),
+        results.end()
+    );
+    
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << "{\n"
+       << "  \"seed\": " << seed << ",\n"
+       << "  \"repetitions\": " << REPETITIONS << ",\n"
+       << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        ss << "    { \"name\": \"" << results[i].name << "\", \"iterations\": " << results[i].iterations
+           << ", \"ns_per_op\": " << results[i].median << ", \"min_ns_per_op\": " << results[i].min << " }"
+           << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    ss << "  ]\n"
+       << "}\n";
+    
+    std::cout << ss.str();
+    if (!output.empty()) {
+        std::ofstream file = std::ofstream(output, std::ios::trunc);
+        file << ss.str();
+        if (!file) {
+            std::cerr << "Error: Could not write report to '" << output << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+#ifndef OPENGL_BENCHMARK_HPP
+#define OPENGL_BENCHMARK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/vec3.hpp>
+
+#include <misc/INonCopyable.hpp>
+#include <tool/Camera.hpp>
+
+
+namespace app {
+    
+    enum BenchmarkPath {
+        BENCHMARK_STRAIGHT, /**< Fly in a straight line, streaming new SuperChunks continuously. */
+        BENCHMARK_SPIRAL,   /**< Fly along a widening spiral, mixing rotation and streaming. */
+        BENCHMARK_TELEPORT, /**< Jump far away at regular intervals, regenerating the whole view. */
+        BENCHMARK_FILE      /**< Follow keyframes recorded in a file. */
+    };
+    
+    
+    
+    /**
+     * Drive the camera along a reproducible path and measure frame times.
+     *
+     * The path is advanced once per tick, so every run visits the same positions whatever the
+     * framerate. Once the path is over, a JSON report is written.
+     *
+     * `update()` is called by the simulation thread, every other method by the render thread.
+     */
+    class Benchmark : public misc::INonCopyable {
+        
+        public:
+            static constexpr GLfloat SPEED = 1.f;          /**< Blocks travelled per tick. */
+            static constexpr GLuint TELEPORT_INTERVAL = 120; /**< Ticks between two teleports. */
+            
+            /** A camera pose of a recorded path. */
+            struct Keyframe {
+                glm::vec3 position;
+                GLfloat pitch;
+                GLfloat yaw;
+            };
+        
+        private:
+            BenchmarkPath path;
+            std::string name;
+            std::vector<Keyframe> keyframes;
+            GLuint seed;
+            GLint distanceView;
+            GLuint ticks;          /**< Duration of the benchmark, in ticks. */
+            GLdouble hitchMs;      /**< Frame time over which a frame is counted as a hitch. */
+            std::string output;
+            
+            std::atomic<GLuint> tick { 0 };
+            GLboolean started = false; /**< Whether a frame was rendered since the path started. */
+            std::vector<GLfloat> frameTimes;
+            std::vector<GLfloat> latencies; /**< Input latency of each frame, in milliseconds. */
+            std::chrono::steady_clock::time_point lastFrame;
+            std::chrono::steady_clock::time_point start;
+            GLuint64 facesDrawn = 0;
+            GLuint64 superChunksAtStart = 0;
+            
+            [[nodiscard]] Keyframe getKeyframe(GLuint tick) const;
+        
+        public:
+            
+            /**
+             * @param name Either "straight", "spiral", "teleport" or the path of a keyframe file.
+             */
+            Benchmark(const std::string &name, GLuint seed, GLint distanceView, GLuint ticks,
+                      GLdouble hitchMs, const std::string &output);
+            
+            /**
+             * Load keyframes written by `appendKeyframe()`, one "x y z pitch yaw" per line.
+             */
+            static std::vector<Keyframe> loadKeyframes(const std::string &path);
+            
+            static void appendKeyframe(const std::string &path, const tool::Camera &camera);
+            
+            [[nodiscard]] GLuint getSeed() const;
+            
+            [[nodiscard]] GLint getDistanceView() const;
+            
+            /**
+             * Move the camera to the pose of the current tick.
+             *
+             * @return false once the path is over.
+             */
+            GLboolean update(tool::Camera &camera);
+            
+            /**
+             * Record the time of a rendered frame.
+             *
+             * @param latency Milliseconds between the last mouse sample used by the camera and the
+             *                presentation of the frame.
+             */
+            void frame(GLuint facesDrawn, GLfloat latency);
+            
+            /**
+             * Write the JSON report to the output file and print it.
+             */
+            void report() const;
+    };
+}
+
+#endif // OPENGL_BENCHMARK_HPP
@@ -36,17 +36,6 @@ namespace app {
             // Time
             static constexpr GLint64 TICK_PER_SEC = 60;
             static constexpr GLint64 MS_PER_TICK = static_cast<GLint64>(1. / TICK_PER_SEC * 1000.);
-            
-            // Terrain generation
-            /** Minimum height when procedurally generating a chunk. */
-            static constexpr GLubyte GEN_MIN_H = 128;
-            /** Maximum height when procedurally generating a chunk. */
-            static constexpr GLubyte GEN_MAX_H = 192;
-            static constexpr GLubyte GEN_CARVING_H = GEN_MIN_H + 30;
-            static constexpr GLubyte GEN_INTERVAL_H = GEN_MAX_H - GEN_MIN_H;
-            static constexpr GLubyte GEN_WATER_LEVEL = GEN_MIN_H + 22;
-            
-            static_assert(GEN_MIN_H < GEN_MAX_H);
         
         private:
             // Time
@@ -60,8 +49,9 @@ namespace app {
             GLfloat tick_dusk_end = tick_per_day / 360 * 220;
             GLuint framerate = 0;      /**< Framerate value. */
             GLuint vSyncFramerate = 0; /**< Framerate when VSYNC is enable. */
-            GLuint usPerFrame = 0;     /**< Number of microseconds between frame. */
+            GLuint usPerFrame = 0;     /**< Number of microseconds between frame, 0 if not paced by a timer. */
             Framerate framerateOpt = Framerate::FRAMERATE_VSYNC;  /**< Chosen Framerate. */
+            GLboolean vSync = false;   /**< Whether buffer swaps are synchronized by the driver. */
             
             // Skybox and lighting
             glm::vec3 dawn_dusk_skybox_col = glm::vec3(255.f, 188.f, 60.f) / 255.f;
@@ -89,21 +79,28 @@ namespace app {
             std::string CPUInfo;     /**< CPU brand and core information. */
             
             // Screen
-            GLint width = 800;      /**< Width of the window. */
-            GLint height = 600;     /**< Height of the window. */
-            GLfloat fov = 70;       /**< Field of view, default to 70. */
-            GLint distanceView = 2; /**< Draw distance as the radius of SuperChunk rendered. */
-            GLboolean debug = true; /**< Display debug or not. */
+            GLint width = 800;                 /**< Width of the window. */
+            GLint height = 600;                /**< Height of the window. */
+            GLfloat fov = 70;                  /**< Field of view, default to 70. */
+            GLint distanceView = 2;            /**< Draw distance as the radius of SuperChunk rendered. */
+            GLboolean adaptiveDistance = true; /**< Lower the draw distance to hold the framerate. */
+            GLfloat renderScale = 1.f;         /**< Share of the resolution of the window the world is rendered at. */
+            GLuint memoryBudget = 1536;        /**< MiB the superchunks may use, in RAM and VRAM, 0 if unlimited. */
+            GLboolean debug = true;            /**< Display debug or not. */
             
             // Control
             GLboolean freeMouse = false;    /**< Allow to freely move the mouse. */
             GLfloat mouseSensitivity = 1.f; /**< Sensitivity of the mouse. */
             GLfloat speed = 0.8f;           /**< Speed of the camera. */
+            GLboolean interpolation = true; /**< Interpolate frames between ticks. */
             
             // Optimization
-            GLboolean faceCulling = true;      /**< Whether face culling is enabled. */
-            GLboolean occlusionCulling = true; /**< Whether occlusion culling is enabled. */
-            GLboolean frustumCulling = true;   /**< Whether frustum culling is enabled. */
+            GLboolean faceCulling = true;       /**< Whether face culling is enabled. */
+            GLboolean occlusionCulling = true;  /**< Whether occlusion culling is enabled. */
+            GLboolean occlusionQueries = true;  /**< Whether chunks hidden by others are skipped by the GPU. */
+            GLboolean softwareOcclusion = true; /**< Whether chunks hidden by the terrain are skipped by the CPU. */
+            GLboolean caveCulling = true;       /**< Whether chunks sealed from the camera are skipped. */
+            GLboolean frustumCulling = true;    /**< Whether frustum culling is enabled. */
             
             Config() = default;
         
@@ -132,6 +129,14 @@ namespace app {
             
             [[maybe_unused]] void setDistanceView(GLint distanceView);
             
+            [[maybe_unused]] void setAdaptiveDistance(GLboolean adaptiveDistance);
+            
+            [[maybe_unused]] void switchAdaptiveDistance();
+            
+            [[maybe_unused]] void setRenderScale(GLfloat renderScale);
+            
+            [[maybe_unused]] void setMemoryBudget(GLuint memoryBudget);
+            
             [[maybe_unused]] void setFreeMouse(GLboolean freeMouse);
             
             [[maybe_unused]] void switchFreeMouse();
@@ -144,10 +149,26 @@ namespace app {
             
             [[maybe_unused]] void switchOcclusionCulling();
             
+            [[maybe_unused]] void setOcclusionQueries(GLboolean occlusionQueries);
+            
+            [[maybe_unused]] void switchOcclusionQueries();
+            
+            [[maybe_unused]] void setSoftwareOcclusion(GLboolean softwareOcclusion);
+            
+            [[maybe_unused]] void switchSoftwareOcclusion();
+            
+            [[maybe_unused]] void setCaveCulling(GLboolean caveCulling);
+            
+            [[maybe_unused]] void switchCaveCulling();
+            
             [[maybe_unused]] void setFrustumCulling(GLboolean frustumCulling);
             
             [[maybe_unused]] void switchFrustumCulling();
             
+            [[maybe_unused]] void setInterpolation(GLboolean interpolation);
+            
+            [[maybe_unused]] void switchInterpolation();
+            
             [[maybe_unused]] void setDebug(GLboolean debug);
             
             [[maybe_unused]] void switchDebug();
@@ -202,6 +223,8 @@ namespace app {
             
             [[nodiscard, maybe_unused]] GLuint getFramerateInv() const;
             
+            [[nodiscard, maybe_unused]] GLboolean getVSync() const;
+            
             [[nodiscard, maybe_unused]] Framerate getFramerateOpt() const;
             
             [[nodiscard, maybe_unused]] std::string getFramerateString(GLint fps = -1) const;
@@ -210,14 +233,28 @@ namespace app {
             
             [[nodiscard, maybe_unused]] GLint getDistanceView() const;
             
+            [[nodiscard, maybe_unused]] GLboolean getAdaptiveDistance() const;
+            
+            [[nodiscard, maybe_unused]] GLfloat getRenderScale() const;
+            
+            [[nodiscard, maybe_unused]] GLuint getMemoryBudget() const;
+            
             [[nodiscard, maybe_unused]] GLboolean getFreeMouse() const;
             
             [[nodiscard, maybe_unused]] GLboolean getFaceCulling() const;
             
             [[nodiscard, maybe_unused]] GLboolean getOcclusionCulling() const;
             
+            [[nodiscard, maybe_unused]] GLboolean getOcclusionQueries() const;
+            
+            [[nodiscard, maybe_unused]] GLboolean getSoftwareOcclusion() const;
+            
+            [[nodiscard, maybe_unused]] GLboolean getCaveCulling() const;
+            
             [[nodiscard, maybe_unused]] GLboolean getFrustumCulling() const;
             
+            [[nodiscard, maybe_unused]] GLboolean getInterpolation() const;
+            
             [[nodiscard, maybe_unused]] GLboolean getDebug() const;
             
             [[nodiscard, maybe_unused]] glm::vec3 getSkyboxColor(GLfloat tick);
@@ -15,29 +15,61 @@
 #include <tool/Rendered.hpp>
 #include <cube/ChunkManager.hpp>
 #include <app/World.hpp>
+#include <app/Benchmark.hpp>
+#include <app/FrameScheduler.hpp>
+#include <app/Governor.hpp>
+#include <app/Simulation.hpp>
+#include <shader/Framebuffer.hpp>
 
 
 namespace app {
     
     class Engine : public misc::ISingleton {
         private:
-            std::chrono::steady_clock::time_point lastTick;
+            std::unique_ptr<FrameScheduler> scheduler = nullptr; /**< Paces the frames of the render thread. */
+            std::unique_ptr<Governor> governor = nullptr;        /**< Adapts the view distance to the framerate. */
+            std::chrono::steady_clock::time_point startTime; /**< Used to measure the time to first frame. */
+            std::chrono::steady_clock::time_point inputSample; /**< When the mouse was last sampled for the camera. */
             GLboolean running = true;
-            GLuint tickSecond = 0;
-            GLuint tickCount = 0;
+            glm::ivec2 headlessSize = glm::ivec2(0); /**< Size of the offscreen target, (0, 0) when windowed. */
+            std::string capturePath;                 /**< Where to save the last frame when headless. */
         
         public:
             std::unique_ptr<tool::ImGuiHandler> imGui = nullptr;
             std::unique_ptr<tool::Window> window = nullptr;
             std::unique_ptr<tool::Camera> camera = nullptr;
             std::unique_ptr<app::World> world = nullptr;
+            std::unique_ptr<app::Simulation> simulation = nullptr;
             std::unique_ptr<tool::Input> input = nullptr;
+            std::unique_ptr<app::Benchmark> benchmark = nullptr; /**< Set to run a benchmark. */
+            std::unique_ptr<shader::Framebuffer> framebuffer = nullptr; /**< Render target when headless. */
+            std::unique_ptr<shader::Framebuffer> scene = nullptr;       /**< World render target when scaled down. */
             
         private:
             
             void debug() const;
             
-            void _render() const;
+            /**
+             * Forward pending SDL events to ImGui or to the input manager.
+             */
+            void pollEvents();
+            
+            /**
+             * Handle the input polled since the last frame, and send the movements and the settings
+             * of the simulation to its next tick.
+             */
+            void control();
+            
+            /**
+             * Create, resize or release the render target of the world so that it matches the
+             * render scale.
+             *
+             * @param width Width of the final image.
+             * @param height Height of the final image.
+             */
+            void updateScene(GLint width, GLint height);
+            
+            void _render();
             
             Engine() = default;
         
@@ -45,14 +77,29 @@ namespace app {
             
             static Engine *getInstance();
             
-            void init();
+            /**
+             * Render offscreen in a `width` x `height` framebuffer instead of a fullscreen window,
+             * must be called before `init()`.
+             *
+             * @param capture If not empty, the last frame is saved as a PNG at this path on cleanup.
+             */
+            void setHeadless(GLint width, GLint height, const std::string &capture);
             
-            GLboolean tick();
+            /**
+             * Create the window and the world, and start the simulation thread.
+             */
+            void init();
             
-            void update();
+            void render();
             
-            void render() const;
+            /**
+             * Sleep until the next frame is due.
+             */
+            void wait() const;
             
+            /**
+             * Stop the simulation thread and release the resources of the render thread.
+             */
             void cleanup();
             
             [[nodiscard]] GLboolean isRunning() const;
@@ -0,0 +1,100 @@
+#ifndef OPENGL_FRAMESCHEDULER_HPP
+#define OPENGL_FRAMESCHEDULER_HPP
+
+#include <chrono>
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace app {
+    
+    /**
+     * Decide when simulation ticks and frames are due, and sleep in between.
+     *
+     * The simulation and the render thread each use their own scheduler, the former for its ticks
+     * and the latter for its frames.
+     */
+    class FrameScheduler : public misc::INonCopyable {
+        
+        public:
+            typedef std::chrono::steady_clock Clock;
+            
+            /** Maximum number of ticks run in a single loop to catch up, older ticks are dropped. */
+            static constexpr GLuint MAX_CATCHUP_TICKS = 5;
+        
+        private:
+            /** Sleeping is not precise, the last part of the wait is spent yielding. */
+            static constexpr std::chrono::microseconds SLEEP_MARGIN = std::chrono::microseconds(500);
+            
+            std::chrono::microseconds tickPeriod;
+            Clock::time_point nextTick;
+            Clock::time_point nextFrame;
+            Clock::duration idle = Clock::duration::zero();   /**< Time spent waiting since the last sample. */
+            Clock::time_point sampleStart;
+            GLuint64 droppedTicks = 0;
+            
+            /**
+             * Sleep, then yield, until `deadline`.
+             */
+            void sleepUntil(Clock::time_point deadline);
+        
+        public:
+            
+            explicit FrameScheduler(GLuint tickPerSec);
+            
+            /**
+             * Restart the deadlines from now, e.g. after a long loading.
+             */
+            void reset();
+            
+            /**
+             * Return the number of ticks that are due and advance the tick deadline accordingly.
+             *
+             * At most `MAX_CATCHUP_TICKS` are returned, the simulation slows down rather than
+             * spiraling if ticks take longer than their period.
+             */
+            GLuint dueTicks();
+            
+            /**
+             * Return whether a frame is due, and advance the frame deadline if so.
+             *
+             * @param usPerFrame Minimum duration between two frames, 0 to render as often as possible.
+             */
+            GLboolean frameDue(GLuint usPerFrame);
+            
+            /**
+             * Sleep until the next frame deadline.
+             *
+             * @param usPerFrame Minimum duration between two frames, 0 if frames are not paced by
+             *                   the scheduler (uncapped or synchronized by the swap interval).
+             */
+            void wait(GLuint usPerFrame);
+            
+            /**
+             * Sleep until the next tick deadline.
+             */
+            void waitTick();
+            
+            /**
+             * Return when the last tick returned by `dueTicks()` was due.
+             */
+            [[nodiscard]] Clock::time_point getLastTick() const;
+            
+            /**
+             * Return how far the current time is between a tick due at `lastTick` and the following
+             * one, from 0 to 1.
+             */
+            [[nodiscard]] GLfloat getTickAlpha(Clock::time_point lastTick) const;
+            
+            /**
+             * Return the percentage of time spent waiting since the last call, and start a new sample.
+             */
+            GLfloat sampleIdle();
+            
+            [[nodiscard]] GLuint64 getDroppedTicks() const;
+    };
+}
+
+#endif // OPENGL_FRAMESCHEDULER_HPP
@@ -0,0 +1,117 @@
+#ifndef OPENGL_GOVERNOR_HPP
+#define OPENGL_GOVERNOR_HPP
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace app {
+    
+    enum GovernorDecision {
+        GOVERNOR_HOLD,         /**< Within the budget, or waiting for the last change to settle. */
+        GOVERNOR_LOADING,      /**< Superchunks of the current radius are still being generated. */
+        GOVERNOR_RAISE,        /**< Well under the budget, the radius was increased. */
+        GOVERNOR_RAISE_SCALE,  /**< Well under the budget, the render scale was increased. */
+        GOVERNOR_LOWER_SCALE,  /**< The GPU exceeded the frame budget, the render scale was decreased. */
+        GOVERNOR_LOWER_FRAME,  /**< Frames exceeded their budget, the radius was decreased. */
+        GOVERNOR_LOWER_UPDATE, /**< Ticks exceeded their period, the radius was decreased. */
+        GOVERNOR_LAST = GOVERNOR_LOWER_UPDATE
+    };
+    
+    
+    
+    /**
+     * Adjust the view distance and the render scale to hold the target framerate.
+     *
+     * The time spent rendering a frame and simulating a tick are smoothed over the last frames,
+     * and compared to the budget of a frame (from `Config::getFramerate()`) and to the period of
+     * a tick. The radius is lowered once either stays above `HIGH_LOAD` of its budget, and raised
+     * once both stay below `LOW_LOAD`, up to the view distance chosen in the settings.
+     *
+     * When frames are bound by the GPU rather than by the CPU, the render scale is lowered first,
+     * down to `MIN_RENDER_SCALE`, and is raised back last.
+     *
+     * The gap between both thresholds, the time they must hold and the cooldown after each change
+     * keep the radius from oscillating, as loading new superchunks briefly raises the tick time.
+     */
+    class Governor : public misc::INonCopyable {
+        
+        public:
+            static constexpr GLint MIN_DISTANCE = 1;           /**< The radius is never lowered below this value. */
+            static constexpr GLfloat MIN_RENDER_SCALE = .5f;   /**< The render scale is never lowered below this value. */
+            static constexpr GLfloat RENDER_SCALE_STEP = .25f; /**< Change of the render scale at each decision. */
+            static constexpr GLfloat HIGH_LOAD = 0.9f;         /**< Share of the budget above which the radius is lowered. */
+            static constexpr GLfloat LOW_LOAD = 0.6f;          /**< Share of the budget below which the radius is raised. */
+            static constexpr GLfloat SMOOTHING = 0.1f;         /**< Weight of a new sample in the moving averages. */
+            static constexpr GLuint LOWER_FRAMES = 30;         /**< Frames over the budget before lowering. */
+            static constexpr GLuint RAISE_FRAMES = 180;        /**< Frames under the budget before raising. */
+            static constexpr GLuint COOLDOWN_FRAMES = 120;     /**< Frames without decision after a change. */
+        
+        private:
+            GLint distance;            /**< Radius in superchunks. */
+            GLfloat scale;             /**< Share of the resolution of the window rendered. */
+            GLfloat cpuMs = 0;         /**< Moving average of the CPU time spent rendering a frame. */
+            GLfloat gpuMs = 0;         /**< Moving average of the GPU time spent rendering a frame. */
+            GLfloat frameMs = 0;       /**< Larger of both. */
+            GLfloat updateMs = 0;      /**< Moving average of the time spent simulating a tick. */
+            GLfloat budgetMs = 0;      /**< Time allowed to render a frame, 0 if not capped. */
+            GLuint overBudget = 0;     /**< Consecutive frames above `HIGH_LOAD`. */
+            GLuint underBudget = 0;    /**< Consecutive frames below `LOW_LOAD`. */
+            GLuint cooldown = 0;       /**< Frames left before the next decision. */
+            GLboolean sampled = false; /**< Whether the moving averages hold a sample. */
+            GovernorDecision decision = GOVERNOR_HOLD;
+            
+            /**
+             * Set the radius and the render scale, and wait for the change to settle before the
+             * next decision.
+             */
+            void change(GLint distance, GLfloat scale, GovernorDecision decision);
+        
+        public:
+            
+            /**
+             * @param distance Initial radius, in superchunks.
+             * @param scale Initial render scale.
+             */
+            Governor(GLint distance, GLfloat scale);
+            
+            /**
+             * Update the radius and the render scale with the measures of the last frame, called
+             * once per frame.
+             *
+             * @param maxDistance View distance chosen in the settings, the radius never exceeds it.
+             * @param maxScale Render scale chosen in the settings, the scale never exceeds it.
+             * @param cpuMs CPU time spent rendering the frame.
+             * @param gpuMs GPU time spent rendering the frame, 0 if not measured.
+             * @param updateMs Time spent simulating a tick.
+             * @param loading Whether the superchunks of the current radius are not all generated
+             *                yet, the tick time is then not representative.
+             */
+            void update(GLint maxDistance, GLfloat maxScale, GLfloat cpuMs, GLfloat gpuMs, GLfloat updateMs,
+                        GLboolean loading);
+            
+            /**
+             * Return the radius to load and render, in superchunks.
+             */
+            [[nodiscard]] GLint getDistanceView() const;
+            
+            /**
+             * Return the share of the resolution of the window to render the world at.
+             */
+            [[nodiscard]] GLfloat getRenderScale() const;
+            
+            [[nodiscard]] GLfloat getFrameMs() const;
+            
+            [[nodiscard]] GLfloat getUpdateMs() const;
+            
+            /** Time allowed to render a frame, 0 if the framerate is not capped. */
+            [[nodiscard]] GLfloat getBudgetMs() const;
+            
+            [[nodiscard]] GovernorDecision getDecision() const;
+            
+            [[nodiscard]] static const char *getDecisionName(GovernorDecision decision);
+    };
+}
+
+#endif // OPENGL_GOVERNOR_HPP
@@ -0,0 +1,150 @@
+#ifndef OPENGL_PROFILER_HPP
+#define OPENGL_PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <GL/glew.h>
+
+#include <misc/ISingleton.hpp>
+#include <tool/QueryRing.hpp>
+
+
+namespace app {
+    
+    enum ProfilerPhase {
+        PHASE_INPUT,
+        PHASE_KEYS,
+        PHASE_GENERATION,
+        PHASE_MESHING,
+        PHASE_UPLOAD,
+        PHASE_VISIBILITY,
+        PHASE_SOFTWARE_OCCLUSION,
+        PHASE_OPAQUE,
+        PHASE_OCCLUSION_QUERIES,
+        PHASE_ALPHA_TEST,
+        PHASE_SKYBOX,
+        PHASE_SUN,
+        PHASE_BLENDED,
+        PHASE_LAST = PHASE_BLENDED
+    };
+    
+    
+    
+    /**
+     * Accumulate the CPU and GPU time spent in each phase of a frame, and keep a rolling history
+     * of the last frames. The number of fragments passing the depth test is also counted for the
+     * phases drawing to the screen.
+     *
+     * CPU times can be added from any thread, everything else must be called from the render
+     * thread.
+     */
+    class Profiler : public misc::ISingleton {
+        
+        public:
+            static constexpr GLuint PHASE_COUNT = PHASE_LAST + 1;
+            static constexpr GLuint HISTORY = 240; /**< Number of frames kept in history. */
+            
+            /**
+             * Add the CPU time elapsed between its construction and its destruction to a phase.
+             */
+            class CpuScope : public misc::INonCopyable {
+                private:
+                    ProfilerPhase phase;
+                    std::chrono::steady_clock::time_point start;
+                
+                public:
+                    explicit CpuScope(ProfilerPhase phase);
+                    
+                    ~CpuScope();
+            };
+            
+            
+            
+            /**
+             * Measure the GPU time and fragments of the commands issued between its construction
+             * and its destruction. GPU scopes cannot be nested, nor contain occlusion queries.
+             */
+            class GpuScope : public misc::INonCopyable {
+                private:
+                    ProfilerPhase phase;
+                
+                public:
+                    explicit GpuScope(ProfilerPhase phase);
+                    
+                    ~GpuScope();
+            };
+        
+        private:
+            std::mutex mutex; /**< Guards `cpuCurrent`, written by every thread. */
+            std::array<GLdouble, PHASE_COUNT> cpuCurrent {};
+            std::array<std::array<GLfloat, HISTORY>, PHASE_COUNT> cpuHistory {};
+            std::array<std::array<GLfloat, HISTORY>, PHASE_COUNT> gpuHistory {};
+            std::array<GLuint, PHASE_COUNT> gpuCursor {};
+            std::array<std::unique_ptr<tool::QueryRing>, PHASE_COUNT> gpuQueries;
+            std::array<std::unique_ptr<tool::QueryRing>, PHASE_COUNT> fragmentQueries;
+            std::array<GLuint64, PHASE_COUNT> fragments {}; /**< Last fragment count read back. */
+            GLuint cpuCursor = 0;
+            GLboolean gpuSupported = false;
+            
+            Profiler() = default;
+        
+        public:
+            
+            static Profiler *getInstance();
+            
+            /**
+             * Create the GPU queries, must be called once an OpenGL context exists.
+             */
+            void init();
+            
+            /**
+             * Release the GPU queries, must be called before the OpenGL context is destroyed.
+             */
+            void cleanup();
+            
+            void addCpuTime(ProfilerPhase phase, GLdouble ms);
+            
+            void beginGpu(ProfilerPhase phase);
+            
+            void endGpu(ProfilerPhase phase);
+            
+            /**
+             * Push the current frame's CPU times into the history and collect available GPU times.
+             */
+            void endFrame();
+            
+            [[nodiscard]] const GLfloat *getCpuHistory(ProfilerPhase phase) const;
+            
+            [[nodiscard]] const GLfloat *getGpuHistory(ProfilerPhase phase) const;
+            
+            /** Index of the oldest value in the CPU history, to use as a plot offset. */
+            [[nodiscard]] GLuint getCpuOffset() const;
+            
+            /** Index of the oldest value in the GPU history of a phase, to use as a plot offset. */
+            [[nodiscard]] GLuint getGpuOffset(ProfilerPhase phase) const;
+            
+            /** Sum of the last GPU time read back of every phase, in milliseconds. */
+            [[nodiscard]] GLfloat getGpuFrameTime() const;
+            
+            /** Whether the GPU time of this phase is measured. */
+            [[nodiscard]] GLboolean hasGpuTime(ProfilerPhase phase) const;
+            
+            /** Number of fragments that passed the depth test in the last measured frame. */
+            [[nodiscard]] GLuint64 getFragments(ProfilerPhase phase) const;
+            
+            /** Whether the fragments of this phase are counted. */
+            [[nodiscard]] GLboolean hasFragments(ProfilerPhase phase) const;
+            
+            [[nodiscard]] static const char *getPhaseName(ProfilerPhase phase);
+            
+            /**
+             * Compute the given percentile (between 0 and 1) of a history.
+             */
+            [[nodiscard]] static GLfloat percentile(const GLfloat *history, GLfloat p);
+    };
+}
+
+#endif // OPENGL_PROFILER_HPP
@@ -0,0 +1,42 @@
+#ifndef OPENGL_RENDERPACKET_HPP
+#define OPENGL_RENDERPACKET_HPP
+
+#include <chrono>
+
+#include <GL/glew.h>
+
+#include <tool/Camera.hpp>
+#include <cube/SuperChunk.hpp>
+#include <cube/ChunkManager.hpp>
+
+
+namespace app {
+    
+    /**
+     * State of the world at the end of a simulation tick, holding everything the render thread
+     * needs to draw a frame.
+     *
+     * Packets are published by `app::Simulation` and never modified afterward, so they can be
+     * read without synchronization.
+     */
+    struct RenderPacket {
+        GLuint64 tick = 0;                          /**< Number of ticks simulated. */
+        std::chrono::steady_clock::time_point time; /**< When the last tick was due. */
+        tool::Camera::Pose previousPose {};         /**< Pose of the camera at the start of the last tick. */
+        tool::Camera::Pose pose {};                 /**< Pose of the camera at the end of the last tick. */
+        GLfloat previousTickCycle = 0;              /**< Time of day at the start of the last tick. */
+        GLfloat tickCycle = 0;                      /**< Time of day at the end of the last tick. */
+        GLboolean underwater = false;               /**< Whether the camera is in water. */
+        GLboolean finished = false;                 /**< Whether the benchmark's path is over. */
+        cube::SuperChunkMeshList superChunks;       /**< Meshes of the loaded superchunks. */
+        GLuint loaded = 0;                          /**< Number of superchunks loaded. */
+        GLuint wanted = 0;                          /**< Number of superchunks within the distance and the budget. */
+        GLuint64 generated = 0;                     /**< Number of superchunks generated since startup. */
+        GLuint64 occludedFace = 0;                  /**< Number of faces hidden by occlusion culling. */
+        GLfloat updateMs = 0;                       /**< Average time spent simulating the last ticks. */
+        cube::MemoryUsage memory {};                /**< Bytes used by the superchunks. */
+        GLboolean memoryBound = false;              /**< Whether the memory budget limits the loaded area. */
+    };
+}
+
+#endif // OPENGL_RENDERPACKET_HPP
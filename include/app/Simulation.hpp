@@ -0,0 +1,118 @@
+#ifndef OPENGL_SIMULATION_HPP
+#define OPENGL_SIMULATION_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <misc/INonCopyable.hpp>
+#include <tool/Camera.hpp>
+#include <cube/ChunkManager.hpp>
+#include <app/Benchmark.hpp>
+#include <app/FrameScheduler.hpp>
+#include <app/RenderPacket.hpp>
+
+
+namespace app {
+    
+    /**
+     * Run the simulation on its own thread at a fixed tick rate: move the camera, advance the time
+     * of day, and load, generate and mesh the superchunks around the camera.
+     *
+     * The render thread never reads the simulated state. It sends its input with `control()`, and
+     * draws the last `app::RenderPacket` published at the end of each batch of ticks.
+     */
+    class Simulation : public misc::INonCopyable {
+        
+        public:
+            
+            /**
+             * Input and settings sampled by the render thread, applied by the next tick.
+             */
+            struct Controls {
+                glm::vec3 move = glm::vec3(0);    /**< Movement along the left, up and front vectors, from -1 to 1. */
+                glm::vec2 look = glm::vec2(0);    /**< Degrees to rotate left and up, accumulated until a tick applies them. */
+                GLboolean switchDayNight = false; /**< Jump to the next day or night, kept until a tick applies it. */
+                GLfloat speed = 0;                /**< Blocks travelled per tick. */
+                GLint distanceView = 0;           /**< Radius of the loaded area, in superchunks. */
+                GLuint64 memoryBudget = 0;        /**< Bytes the superchunks may use, 0 if unlimited. */
+                GLboolean occlusionCulling = true;
+            };
+        
+        private:
+            cube::ChunkManager chunkManager;
+            tool::Camera camera;
+            Benchmark *benchmark;
+            FrameScheduler scheduler;
+            GLuint64 tick = 0;
+            GLfloat tickCycle = 0;
+            GLfloat previousTickCycle = 0;
+            GLuint64 generated = 0;
+            GLfloat updateMs = 0;
+            GLboolean underwater = false;
+            GLboolean finished = false;
+            
+            std::thread thread;
+            std::atomic<bool> running { false };
+            mutable std::mutex mutex;                  /**< Guards the members below. */
+            mutable std::condition_variable published; /**< Notified when a packet is published. */
+            Controls controls;                         /**< Controls not yet taken by a tick. */
+            glm::vec2 inFlightLook = glm::vec2(0);     /**< Rotation taken by ticks whose packet is not published yet. */
+            std::shared_ptr<const RenderPacket> packet = nullptr;
+            std::exception_ptr error = nullptr;        /**< Exception that stopped the thread. */
+            
+            void run();
+            
+            /**
+             * Take the controls sent since the last tick, keeping the persistent settings.
+             */
+            Controls takeControls();
+            
+            void update(const Controls &controls);
+            
+            void publish();
+        
+        public:
+            
+            /**
+             * @param pose Initial pose of the camera.
+             * @param benchmark If not null, the camera follows the benchmark's path.
+             */
+            Simulation(const tool::Camera::Pose &pose, Benchmark *benchmark);
+            
+            ~Simulation();
+            
+            void start();
+            
+            /**
+             * Stop the thread, waiting for the current tick to end.
+             */
+            void stop();
+            
+            /**
+             * Send the input of the render thread to the next tick.
+             */
+            void control(const Controls &controls);
+            
+            /**
+             * Return the last published packet.
+             *
+             * @param pendingLook Set to the rotation sent with `control()` that the packet does not
+             *                    include yet, to be applied on top of its poses.
+             */
+            std::shared_ptr<const RenderPacket> getPacket(glm::vec2 &pendingLook) const;
+            
+            /**
+             * Block until a packet of at least `tick` is published, and return it.
+             */
+            std::shared_ptr<const RenderPacket> waitPacket(GLuint64 tick) const;
+    };
+}
+
+#endif // OPENGL_SIMULATION_HPP
@@ -12,6 +12,8 @@ namespace app {
         
         public:
             GLuint fps;                     /**< Current FPS/ */
+            GLfloat idle = 0;               /**< Percentage of time the main loop spent waiting. */
+            GLfloat inputLatency = 0;       /**< Milliseconds between the last mouse sample and the frame. */
             GLuint l_superchunk = 0;        /**< Number of SuperChunk loaded. */
             GLuint l_chunk = 0;             /**< Number of Chunk loaded. */
             GLuint l_cube = 0;              /**< Number of cube loaded. */
@@ -20,8 +22,19 @@ namespace app {
             GLuint r_chunk = 0;             /**< Number of Chunk rendered. */
             GLuint r_cube = 0;              /**< Number of cube rendered. */
             GLuint r_face = 0;              /**< Number of face rendered. */
+            GLuint occludedChunk = 0;       /**< Number of Chunk hidden by occlusion queries, not in r_chunk. */
+            GLuint occlusionQuery = 0;      /**< Number of occlusion queries issued in the last frame. */
+            GLuint culledChunk = 0;         /**< Number of Chunk hidden behind the software rasterizer's occluders. */
+            GLuint sealedChunk = 0;         /**< Number of Chunk unreachable from the camera through non-opaque cubes. */
             GLuint64 occludedFace = 0;      /**< Number of face occluded. */
             GLuint64 frustumCulledFace = 0; /**< Number of face culled. */
+            GLuint64 g_superchunk = 0;      /**< Number of SuperChunk generated since startup. */
+            GLuint glObject = 0;            /**< Number of GL buffers, vertex arrays and queries of the chunks. */
+            GLuint64 g_glObject = 0;        /**< Number of those created since startup. */
+            GLdouble glObjectMs = 0;        /**< Milliseconds spent creating them since startup. */
+            GLuint64 voxelBytes = 0;        /**< Bytes of the cubes of the loaded and pooled SuperChunk. */
+            GLuint64 meshBytes = 0;         /**< Bytes of the meshes kept in memory by the simulation. */
+            GLuint64 bufferBytes = 0;       /**< Bytes of the faces uploaded to the GPU. */
             
         private:
             
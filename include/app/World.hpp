@@ -1,27 +1,53 @@
 #ifndef OPENGL_WORLD_HPP
 #define OPENGL_WORLD_HPP
 
+#include <memory>
+
 #include <tool/Rendered.hpp>
 #include <misc/ISingleton.hpp>
-#include <cube/ChunkManager.hpp>
+#include <shader/UniformBuffer.hpp>
+#include <cube/ChunkRenderer.hpp>
 #include <entity/Skybox.hpp>
 #include <entity/Sun.hpp>
+#include <app/RenderPacket.hpp>
 
 
 namespace app {
+    /**
+     * Render side of the world, drawing the `app::RenderPacket` published by the simulation.
+     */
     class World : public misc::ISingleton, public tool::Rendered {
-    
+        
+        private:
+            GLuint64 uploadedTick = 0; /**< Tick of the last packet uploaded. */
+            std::unique_ptr<shader::UniformBuffer> frameUniforms = nullptr;
+            
+            /**
+             * Write the camera, lighting and sky of the current frame to the `Frame` uniform block.
+             */
+            void updateFrameUniforms() const;
+        
         public:
-            std::unique_ptr<cube::ChunkManager> chunkManager = nullptr;
+            std::unique_ptr<cube::ChunkRenderer> chunkRenderer = nullptr;
             std::unique_ptr<entity::Skybox> skybox;
             std::unique_ptr<entity::Sun> sun = nullptr;
+            std::shared_ptr<const RenderPacket> packet = nullptr; /**< State drawn by the current frame. */
             GLboolean underwater = false;
-            GLfloat tickCycle = 0;
-
+            GLfloat renderTickCycle = 0;   /**< Time of day interpolated for the current frame. */
+            
             World();
-        
+            
+            /**
+             * Upload the meshes of `packet` if it changed since the last call.
+             */
             void update() override;
-        
+            
+            /**
+             * Compute the state rendered in the current frame, between the start of the last tick
+             * of `packet` (`alpha` = 0) and its end (`alpha` = 1).
+             */
+            void interpolate(GLfloat alpha);
+            
             void render() const override;
     };
 }
@@ -1,6 +1,7 @@
 #ifndef OPENGL_CHUNK_H
 #define OPENGL_CHUNK_H
 
+#include <memory>
 #include <vector>
 
 #include <GL/glew.h>
@@ -8,10 +9,18 @@
 
 #include <misc/INonCopyable.hpp>
 #include <cube/CubeData.hpp>
+#include <cube/ChunkMesh.hpp>
+#include <cube/IVoxelSource.hpp>
 
 
 namespace cube {
     
+    /**
+     * Cubes of a 16x16x16 area and their mesh.
+     *
+     * Chunks do not own any GPU resource, meshes are uploaded by a `cube::ChunkBuffer`. A mesh is
+     * never modified once built, rebuilding the chunk replaces it.
+     */
     class Chunk : public misc::INonCopyable {
         public:
             static constexpr GLint X = 16;
@@ -20,46 +29,52 @@ namespace cube {
             static constexpr GLint SIZE = X * Y * Z;
         
         private:
-            static constexpr GLuint VERTEX_ATTR_POSITION = 0;
-            static constexpr GLuint VERTEX_ATTR_NORMAL = 1;
-            static constexpr GLuint VERTEX_ATTR_TEXTURE = 2;
-            static constexpr GLuint VERTEX_ATTR_DATA = 3;
-            
             CubeData cubes[X][Y][Z] {};
             glm::ivec3 position = glm::ivec3(0);
             GLboolean modified = true;
-            GLuint countAlpha = 0;
-            GLuint vboAlpha = 0;
-            GLuint vaoAlpha = 0;
-            GLuint count = 0;
-            GLuint vbo = 0;
-            GLuint vao = 0;
+            std::shared_ptr<const ChunkMesh> mesh = std::make_shared<const ChunkMesh>();
             
             [[nodiscard]] static bool onBorder(GLubyte x, GLubyte y, GLubyte z);
             
-            [[nodiscard]] bool occluded(CubeData type, GLint x, GLint y, GLint z,
-                                        CubeData direction) const;
+            [[nodiscard]] bool occluded(const IVoxelSource &world, CubeData type, GLint x, GLint y,
+                                        GLint z, CubeData direction) const;
             
             [[nodiscard]] static GLushort computeData(CubeData type, CubeData direction,
                                                bool opaqueAbove) ;
+            
+            /**
+             * Flood fill the non-opaque cubes to find which sides of the chunk can be seen from
+             * the others.
+             *
+             * @return A mask of the connected pairs of sides, see `connectionBit()`.
+             */
+            [[nodiscard]] GLushort computeConnectivity() const;
         
         public:
             
-            Chunk();
+            Chunk() = default;
             
-            ~Chunk();
-            
-            CubeData get(GLubyte x, GLubyte y, GLubyte z);
+            [[nodiscard]] CubeData get(GLubyte x, GLubyte y, GLubyte z) const;
             
             void set(GLubyte x, GLubyte y, GLubyte z, CubeData type);
             
             void setPosition(GLint x, GLint y, GLint z);
             
+            [[nodiscard]] glm::ivec3 getPosition() const;
+            
             void touch();
             
-            GLuint update();
+            /**
+             * Rebuild the mesh if the chunk was modified.
+             *
+             * @param world Used to check the neighbours of cubes on the border of the chunk.
+             * @param occlusionCulling Whether faces hidden by an opaque neighbour are skipped.
+             *
+             * @return The number of faces of the mesh.
+             */
+            GLuint update(const IVoxelSource &world, GLboolean occlusionCulling);
             
-            GLuint render(bool alpha) const;
+            [[nodiscard]] const std::shared_ptr<const ChunkMesh> &getMesh() const;
     };
 }
 
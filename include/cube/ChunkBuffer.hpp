@@ -0,0 +1,166 @@
+#ifndef OPENGL_CHUNKBUFFER_HPP
+#define OPENGL_CHUNKBUFFER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <misc/INonCopyable.hpp>
+#include <cube/ChunkMesh.hpp>
+#include <cube/VertexArrayPool.hpp>
+
+
+namespace cube {
+    
+    /**
+     * GPU copy of the mesh of a chunk, and state of its occlusion query.
+     *
+     * A chunk found hidden by its last occlusion query is drawn with conditional rendering, the
+     * GPU skipping it if the query issued in the current frame found it hidden too.
+     *
+     * Most chunks are made only of air or of buried cubes, GL objects are thus only created once
+     * needed: the buffer and vertex array of a material with its first face, and the query with
+     * the first occlusion query. Those of a material are released to a `cube::VertexArrayPool`
+     * once it has no face anymore, and taken back from it before creating new ones.
+     */
+    class ChunkBuffer : public misc::INonCopyable {
+        
+        public:
+            /** Number of frames between two occlusion queries of a visible chunk. */
+            static constexpr GLuint QUERY_INTERVAL = 8;
+        
+        private:
+            static constexpr GLuint VERTEX_ATTR_POSITION = 0;
+            static constexpr GLuint VERTEX_ATTR_NORMAL = 1;
+            static constexpr GLuint VERTEX_ATTR_TEXTURE = 2;
+            static constexpr GLuint VERTEX_ATTR_DATA = 3;
+            
+            GLuint vbo[MATERIAL_COUNT] = {}; /**< 0 while the material has no face. */
+            GLuint vao[MATERIAL_COUNT] = {}; /**< 0 while the material has no face. */
+            GLuint count[MATERIAL_COUNT] = {}; /**< Number of faces of each material. */
+            GLuint sides[SIDE_COUNT + 1] = {};  /**< Range of the opaque faces of each side, see `ChunkMesh::sides`. */
+            GLuint cubeCount = 0;
+            GLuint64 version = 0; /**< Version of the uploaded mesh, 0 if nothing was uploaded. */
+            GLuint query = 0;           /**< 0 until the chunk is first queried. */
+            GLboolean visible = true;   /**< Whether the chunk was visible at its last occlusion query. */
+            GLboolean pending = false;  /**< Whether the result of the last occlusion query was not read yet. */
+            GLboolean culled = false;   /**< Whether the chunk is hidden according to the software rasterizer. */
+            GLboolean reachable = true; /**< Whether the visibility walk from the camera reached the chunk. */
+            GLushort connectivity = CONNECTED_ALL; /**< Connectivity of the uploaded mesh. */
+            
+            static void setAttributes(GLuint vao, GLuint vbo);
+            
+            /**
+             * Take the buffer and the vertex array of a material from the pool, creating them if
+             * it is empty.
+             */
+            void allocate(Material material, VertexArrayPool &pool);
+            
+            /**
+             * Give the buffer and the vertex array of a material back to the pool.
+             */
+            void release(Material material, VertexArrayPool &pool);
+        
+        public:
+            
+            ChunkBuffer() = default;
+            
+            ~ChunkBuffer();
+            
+            /**
+             * Forget the uploaded mesh and the state of the occlusion query, keeping the GL
+             * objects for the next upload.
+             */
+            void reset();
+            
+            /**
+             * Upload the given mesh if it changed since the last upload.
+             *
+             * @param pool Buffers and vertex arrays of the materials are taken from and released
+             *             to this pool.
+             *
+             * @return Whether the mesh was uploaded.
+             */
+            bool upload(const ChunkMesh &mesh, VertexArrayPool &pool);
+            
+            /**
+             * Draw the faces of the given material, conditionally to the last occlusion query if
+             * the chunk is hidden.
+             *
+             * @param sides Mask of the sides whose opaque faces are drawn, ignored for the other
+             *              materials.
+             *
+             * @return The number of faces drawn, 0 if drawn conditionally.
+             */
+            GLuint render(Material material, GLubyte sides = SIDES_ALL) const;
+            
+            /**
+             * Return the mask of the sides whose faces can face a camera at the given position, for
+             * a chunk at `position`.
+             */
+            [[nodiscard]] static GLubyte getFacingSides(const glm::vec3 &position, const glm::vec3 &camera);
+            
+            /**
+             * Read the result of the last occlusion query if it is available, without waiting for it.
+             */
+            void readQuery();
+            
+            /**
+             * Whether the chunk must be queried during the given frame. Hidden chunks are queried
+             * every frame, visible chunks every `QUERY_INTERVAL` frames.
+             */
+            [[nodiscard]] bool needsQuery(GLuint64 frame) const;
+            
+            /**
+             * Start an occlusion query, every sample passing the depth test until `endQuery()`
+             * makes the chunk visible.
+             */
+            void beginQuery();
+            
+            void endQuery();
+            
+            /**
+             * Consider the chunk visible until its next query, discarding any pending result.
+             */
+            void setVisible();
+            
+            [[nodiscard]] GLboolean isVisible() const;
+            
+            /**
+             * Set whether the chunk is hidden behind the occluders of the current frame, in which
+             * case it is neither drawn nor queried.
+             */
+            void setCulled(GLboolean culled);
+            
+            [[nodiscard]] GLboolean isCulled() const;
+            
+            /**
+             * Set whether the chunk can be seen from the camera through non-opaque cubes, an
+             * unreachable chunk is neither drawn nor queried.
+             */
+            void setReachable(GLboolean reachable);
+            
+            [[nodiscard]] GLboolean isReachable() const;
+            
+            /**
+             * Whether the chunk is culled or unreachable, and must not be drawn nor queried.
+             */
+            [[nodiscard]] bool isSkipped() const;
+            
+            /**
+             * Whether the given sides are connected through non-opaque cubes, a side is always
+             * connected to itself.
+             */
+            [[nodiscard]] bool connects(Side a, Side b) const;
+            
+            /**
+             * Whether the chunk has no face of any material.
+             */
+            [[nodiscard]] bool isEmpty() const;
+            
+            [[nodiscard]] GLuint getFaceCount(Material material) const;
+            
+            [[nodiscard]] GLuint getCubeCount() const;
+    };
+}
+
+#endif // OPENGL_CHUNKBUFFER_HPP
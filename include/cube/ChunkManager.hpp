@@ -1,26 +1,19 @@
 #ifndef OPENGL_CHUNKMANAGER_HPP
 #define OPENGL_CHUNKMANAGER_HPP
 
-#include <map>
 #include <vector>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 
-#include <glm/gtc/noise.hpp>
-
 #include <misc/INonCopyable.hpp>
-#include <shader/ShaderTexture.hpp>
-#include <misc/Noise.hpp>
+#include <cube/IVoxelSource.hpp>
 #include <cube/SuperChunk.hpp>
+#include <cube/TerrainGenerator.hpp>
 
 
 namespace cube {
     
-    typedef misc::Noise<glm::vec2, float, glm::simplex> Noise2D;
-    typedef misc::Noise<glm::vec3, float, glm::simplex> Noise3D;
-    
-    
-    
     struct Ivec3Hash {
         size_t operator()(const glm::ivec3 &k) const {
             return std::hash<int>()(k.x) ^ std::hash<int>()(k.y) ^ std::hash<int>()(k.z);
@@ -32,46 +25,109 @@ namespace cube {
         }
     };
     
+    typedef std::unordered_map<glm::ivec3, std::unique_ptr<SuperChunk>, Ivec3Hash> SuperChunkMap;
+    
+    /**
+     * Bytes used by the superchunks of a `cube::ChunkManager`.
+     */
+    struct MemoryUsage {
+        GLuint64 voxels = 0;  /**< Cubes of the loaded and pooled superchunks. */
+        GLuint64 meshes = 0;  /**< Meshes of the chunks kept in memory. */
+        GLuint64 buffers = 0; /**< Faces uploaded to the GPU, as estimated from the meshes. */
+        
+        [[nodiscard]] GLuint64 getTotal() const {
+            return this->voxels + this->meshes + this->buffers;
+        }
+    };
+    
     
     
-    class ChunkManager : public misc::INonCopyable {
+    /**
+     * Keep the superchunks around a position loaded, generated and meshed.
+     *
+     * Unloaded superchunks are kept in a pool and recycled by the next loads, moving across the
+     * world thus neither allocates nor frees superchunks once the pool holds a row of them.
+     *
+     * With a memory budget, only the superchunks nearest to the center fitting in it are loaded,
+     * the farthest being unloaded first. The loaded area grows back one ring at a time, once the
+     * next ring fits in `GROW_LOAD` of the budget.
+     *
+     * The manager does not issue any GL call, the meshes it produces are uploaded and drawn by
+     * `cube::ChunkRenderer`.
+     */
+    class ChunkManager : public IVoxelSource, public misc::INonCopyable {
         
         private:
-            std::unordered_map<glm::ivec3, std::unique_ptr<cube::SuperChunk>, Ivec3Hash> chunks;
+            /** Share of the budget the superchunks must fit in for the loaded area to grow. */
+            static constexpr GLfloat GROW_LOAD = 0.9f;
+            
+            SuperChunkMap chunks;
+            std::vector<SuperChunkMap::node_type> pool; /**< Unloaded superchunks, recycled by the next loads. */
             std::vector<glm::ivec3> keys;
-            GLuint textureVerticalOffset;
-            Noise2D temperatureNoise;
-            Noise3D carvingNoise;
+            TerrainGenerator generator;
+            /** Squared horizontal distance to the center under which superchunks fit in the budget. */
+            GLint budgetDistance = std::numeric_limits<GLint>::max();
+            GLboolean memoryBound = false;
+            
+            /**
+             * Return the average bytes used by a loaded superchunk, those not meshed yet being
+             * assumed as large as the others.
+             */
+            [[nodiscard]] GLuint64 getSuperChunkBytes() const;
         
         public:
-            std::unique_ptr<shader::ShaderTexture> cubeShader;
-            shader::Texture cubeTexture;
             
-            Noise2D heightNoise;
-        
-        private:
+            ChunkManager() = default;
             
-            void generateKeys();
+            void clearChunks();
             
-            [[nodiscard]] static cube::CubeData getBiome(GLuint height, GLfloat temperature);
+            [[nodiscard]] static glm::ivec3 getSuperChunkCoordinates(const glm::ivec3 &position);
             
-            [[nodiscard]] cube::SuperChunk *createSuperChunk(glm::ivec3 position);
-        
-        public:
+            [[nodiscard]] CubeData get(const glm::ivec3 &position) const override;
             
-            explicit ChunkManager(const misc::Image *t_cubeTexture);
+            /**
+             * Compute the superchunks within `distanceView` of `center` and unload the others.
+             *
+             * @param budget Bytes the superchunks may use, see `getMemoryUsage()`, 0 if unlimited.
+             */
+            void updateKeys(const glm::ivec3 &center, GLint distanceView, GLuint64 budget = 0);
             
-            void clearChunks();
-        
-            [[nodiscard]] static glm::ivec3 getSuperChunkCoordinates(const glm::ivec3 &position);
+            /**
+             * Generate every missing superchunk computed by the last call to `updateKeys()`.
+             *
+             * @return The number of generated superchunks.
+             */
+            GLuint generate();
+            
+            /**
+             * Rebuild the mesh of every modified chunk.
+             */
+            void mesh(GLboolean occlusionCulling);
+            
+            [[nodiscard]] const SuperChunkMap &getSuperChunks() const;
+            
+            /**
+             * Return the meshes of every meshed superchunk, as of the last call to `mesh()`.
+             */
+            [[nodiscard]] SuperChunkMeshList getMeshes() const;
+            
+            [[nodiscard]] const TerrainGenerator &getGenerator() const;
             
-            [[nodiscard]] cube::CubeData get(const glm::ivec3 &position) const;
+            [[nodiscard]] GLuint getOccludedCount() const;
             
-            void init();
+            [[nodiscard]] MemoryUsage getMemoryUsage() const;
             
-            void update();
+            /**
+             * Whether superchunks within the view distance were left unloaded by the last call to
+             * `updateKeys()` to fit in the memory budget.
+             */
+            [[nodiscard]] GLboolean isMemoryBound() const;
             
-            void render();
+            /**
+             * Return the number of superchunks to load, as computed by the last call to
+             * `updateKeys()`.
+             */
+            [[nodiscard]] GLuint getKeyCount() const;
     };
 }
 
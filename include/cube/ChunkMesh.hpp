@@ -0,0 +1,91 @@
+#ifndef OPENGL_CHUNKMESH_HPP
+#define OPENGL_CHUNKMESH_HPP
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <cube/CubeData.hpp>
+#include <cube/CubeFace.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Side of a chunk, the opposite of a side is `side ^ 1`.
+     */
+    enum Side : GLubyte {
+        SIDE_NEG_X,
+        SIDE_POS_X,
+        SIDE_NEG_Y,
+        SIDE_POS_Y,
+        SIDE_NEG_Z,
+        SIDE_POS_Z,
+        SIDE_LAST = SIDE_POS_Z
+    };
+    
+    /** Number of sides of a chunk. */
+    static constexpr GLuint SIDE_COUNT = SIDE_LAST + 1;
+    
+    /** Mask of every side of a chunk, one bit per `Side`. */
+    static constexpr GLubyte SIDES_ALL = (1u << SIDE_COUNT) - 1;
+    
+    /** Connectivity of a chunk whose every side is connected to the others. */
+    static constexpr GLushort CONNECTED_ALL = (1u << 15u) - 1;
+    
+    /**
+     * Return the bit of a connectivity mask telling whether two different sides are connected,
+     * one bit for each of the 15 pairs of sides.
+     */
+    static constexpr GLushort connectionBit(Side a, Side b) {
+        GLuint low = a < b ? a : b;
+        GLuint high = a < b ? b : a;
+        return static_cast<GLushort>(1u << (low * (11 - low) / 2 + high - low - 1));
+    }
+    
+    
+    
+    /**
+     * Faces of a chunk built on the CPU, ready to be uploaded to the GPU.
+     */
+    struct ChunkMesh {
+        std::vector<CubeFace> faces[MATERIAL_COUNT]; /**< Faces of each class of material. */
+        GLuint cubeCount = 0;                        /**< Number of cube with at least one visible face. */
+        GLuint occludedCount = 0;                    /**< Number of face hidden by occlusion culling. */
+        GLuint64 version = 0;                        /**< Unique to each built mesh, 0 if never built. */
+        /**
+         * Opaque faces are sorted by side, the faces of side `s` are `faces[MATERIAL_OPAQUE]`
+         * from `sides[s]` to `sides[s + 1]`.
+         */
+        GLuint sides[SIDE_COUNT + 1] = {};
+        /**
+         * Pairs of sides connected through non-opaque cubes, see `connectionBit()`. A chunk
+         * never built is considered connected everywhere.
+         */
+        GLushort connectivity = CONNECTED_ALL;
+        
+        /**
+         * Return the number of faces of every material.
+         */
+        [[nodiscard]] GLuint getFaceCount() const {
+            GLuint count = 0;
+            for (const std::vector<CubeFace> &material : this->faces) {
+                count += static_cast<GLuint>(material.size());
+            }
+            return count;
+        }
+        
+        /**
+         * Return the bytes used by the mesh in memory, including the capacity of its vectors.
+         */
+        [[nodiscard]] GLuint64 getByteSize() const {
+            GLuint64 bytes = sizeof(ChunkMesh);
+            for (const std::vector<CubeFace> &material : this->faces) {
+                bytes += material.capacity() * sizeof(CubeFace);
+            }
+            return bytes;
+        }
+    };
+}
+
+#endif // OPENGL_CHUNKMESH_HPP
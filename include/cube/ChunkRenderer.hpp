@@ -0,0 +1,169 @@
+#ifndef OPENGL_CHUNKRENDERER_HPP
+#define OPENGL_CHUNKRENDERER_HPP
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include <misc/INonCopyable.hpp>
+#include <misc/Image.hpp>
+#include <shader/ShaderTexture.hpp>
+#include <shader/uniform/Uniform.hpp>
+#include <shader/TextureArray.hpp>
+#include <cube/ChunkManager.hpp>
+#include <cube/DepthRasterizer.hpp>
+#include <cube/SuperChunkBuffer.hpp>
+#include <cube/VertexArrayPool.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Upload the meshes built by a `cube::ChunkManager` and draw them.
+     *
+     * Meshes are received as immutable snapshots, the renderer never reads the superchunks
+     * themselves, which belong to the simulation thread.
+     *
+     * Like the superchunks of `cube::ChunkManager`, the buffers of unloaded superchunks are kept
+     * in a pool and recycled with their GL objects by the next loads.
+     */
+    class ChunkRenderer : public misc::INonCopyable {
+        
+        private:
+            /**
+             * Radius of the square of superchunks around the camera drawing occluders, in
+             * superchunks. Farther occluders cover too few pixels to be worth drawing.
+             */
+            static constexpr GLint OCCLUDER_DISTANCE = 2;
+            
+            /**
+             * Chunk reached by the visibility walk.
+             */
+            struct WalkStep {
+                SuperChunkBuffer *superChunk;
+                glm::ivec3 chunk;   /**< Position of the chunk in its superchunk, in chunks. */
+                Side from;          /**< Side through which the chunk was entered. */
+                GLubyte directions; /**< Sides crossed since the camera's chunk, 0 for the camera's chunk. */
+            };
+            
+            typedef std::unordered_map<glm::ivec3, std::unique_ptr<SuperChunkBuffer>, Ivec3Hash> SuperChunkBufferMap;
+            
+            SuperChunkBufferMap buffers;
+            std::vector<SuperChunkBufferMap::node_type> pool; /**< Buffers of unloaded superchunks. */
+            VertexArrayPool vertexArrays;                     /**< Released by chunks left without faces. */
+            shader::Uniform<glm::vec3> uChunkPosition[MATERIAL_COUNT];
+            std::vector<SuperChunkBuffer::ChunkDraw> draws[MATERIAL_COUNT]; /**< Chunks of each material, nearest first. */
+            std::vector<SuperChunkBuffer::ChunkDraw> sortScratch;           /**< Kept to reuse its allocation. */
+            std::vector<WalkStep> walk;                                     /**< Kept to reuse its allocation. */
+            std::unique_ptr<OcclusionQueries> occlusionQueries = nullptr;
+            DepthRasterizer rasterizer;
+            GLuint64 frame = 0;
+            GLuint64 updates = 0;
+        
+        public:
+            /** Variant of the cube program compiled for each material, see `cube::Material`. */
+            std::unique_ptr<shader::ShaderTexture> cubeShaders[MATERIAL_COUNT];
+            shader::TextureArray cubeTexture;
+        
+        private:
+            
+            [[nodiscard]] static std::vector<std::unique_ptr<misc::Image>> splitAtlas(const misc::Image *atlas);
+            
+            /**
+             * Sort draws from the nearest to the farthest chunk, with a radix sort on their distance.
+             *
+             * @param scratch Buffer of the sort, resized to the number of draws.
+             */
+            static void sortDraws(std::vector<SuperChunkBuffer::ChunkDraw> &draws,
+                                  std::vector<SuperChunkBuffer::ChunkDraw> &scratch);
+            
+            /**
+             * Fill `draws[material]` with the chunks having faces of the given material, nearest
+             * first.
+             */
+            void collectDraws(Material material, const glm::vec3 &camera);
+            
+            /**
+             * Draw the faces of the chunks collected for the given material, from the nearest to
+             * the farthest, with its variant of the program.
+             *
+             * @param visible Whether to draw the chunks visible at their last occlusion query, or
+             *                the hidden ones (conditionally to their query).
+             * @param camera Position of the camera, used to skip the faces looking away from it.
+             *
+             * @return The number of faces drawn.
+             */
+            GLuint renderDraws(Material material, GLboolean visible, const glm::vec3 &camera) const;
+            
+            /**
+             * Issue the occlusion queries of this frame.
+             *
+             * @return The number of queries issued.
+             */
+            GLuint queryOcclusion(const glm::vec3 &camera);
+            
+            /**
+             * Walk from the camera's chunk through the non-opaque cubes of the chunks, never going
+             * back toward the camera, and mark the chunks reached. Chunks sealed from the camera,
+             * like caves deep in the ground, are not reached.
+             *
+             * @return The number of non-empty chunks not reached.
+             */
+            GLuint walkVisibility(const glm::vec3 &camera);
+            
+            /**
+             * Rasterize the occluders of the superchunks near the camera, and cull the superchunks
+             * and chunks hidden behind them.
+             *
+             * @return The number of chunks culled.
+             */
+            GLuint cull(const glm::vec3 &camera, const glm::mat4 &viewProjection);
+            
+            /**
+             * Draw the translucent faces chunk by chunk, from the farthest to the nearest chunk.
+             *
+             * @return The number of faces drawn.
+             */
+            GLuint renderBlended(const glm::vec3 &camera);
+        
+        public:
+            
+            explicit ChunkRenderer(const misc::Image *t_cubeTexture);
+            
+            void init();
+            
+            /**
+             * Move the buffers of unloaded superchunks to the pool and upload the meshes that
+             * changed.
+             *
+             * @param meshes Meshes of every loaded superchunk.
+             */
+            void update(const SuperChunkMeshList &meshes);
+            
+            /**
+             * Draw the opaque then the alpha-tested faces of the loaded superchunks without
+             * blending, from the nearest to the farthest chunk so that the depth test rejects the
+             * hidden fragments before shading. The `Frame` uniform block must be up to date.
+             *
+             * If enabled, chunks sealed from the camera and chunks hidden behind the solid ground
+             * are culled on the CPU first, then chunks hidden at their last occlusion query are
+             * queried again once the opaque faces of the visible chunks are drawn, and are drawn
+             * conditionally to it.
+             *
+             * @param camera Position of the camera, used to sort the chunks.
+             * @param viewProjection Projection and view matrices of the camera, used to cull chunks.
+             */
+            void renderOpaque(const glm::vec3 &camera, const glm::mat4 &viewProjection);
+            
+            /**
+             * Draw the translucent faces of the chunks drawn by the last `renderOpaque()`, back to
+             * front by chunk and without writing depth. Must be called once everything behind
+             * them, including the sky, is drawn.
+             *
+             * @param camera Position of the camera, used to sort the chunks.
+             */
+            void renderTranslucent(const glm::vec3 &camera);
+    };
+}
+
+#endif // OPENGL_CHUNKRENDERER_HPP
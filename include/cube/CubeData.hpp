@@ -17,6 +17,11 @@ namespace cube {
      * rendered (eg. leaves).
      */
     static constexpr GLushort NOT_FLOOR = 1u << 14u;
+    /**
+     * Tell if the block is translucent, meaning it is blended with what is
+     * behind it instead of being alpha tested (eg. water).
+     */
+    static constexpr GLushort TRANSLUCENT = 1u << 15u;
     
     /**
      * Offset for the the face direction bits.
@@ -36,11 +41,24 @@ namespace cube {
         return static_cast<GLushort>(x | (y << 4u));
     }
     
+    /** Number of texture columns in the block atlas. */
+    static constexpr GLuint ATLAS_COLUMNS = 8;
+    /** Number of tile rows in the block atlas, every block using one row per face. */
+    static constexpr GLuint ATLAS_ROWS = 32;
+    /** Number of block rows (as given to `textureLoc()`) actually used in the atlas. */
+    static constexpr GLuint ATLAS_BLOCK_ROWS = 4;
+    /** Number of frames of animated textures, stored at half tile height in the first column. */
+    static constexpr GLuint ATLAS_FRAMES = 32;
+    /** Index of the first animation frame in the block texture array. */
+    static constexpr GLuint ATLAS_ANIMATED_LAYER = ATLAS_COLUMNS * ATLAS_BLOCK_ROWS * 6;
+    /** Number of layers in the block texture array. */
+    static constexpr GLuint ATLAS_LAYERS = ATLAS_ANIMATED_LAYER + ATLAS_FRAMES;
+    
     
     enum CubeData : GLushort {
         // Block types
         AIR = 0u | ALPHA | NOT_FLOOR, // Empty block, not present in the texture atlas.
-        WATER = textureLoc(0, 0) | ALPHA | ANIMATED,
+        WATER = textureLoc(0, 0) | ALPHA | ANIMATED | TRANSLUCENT,
         SAND_BEACH = textureLoc(2, 0),
         ICE = textureLoc(3, 0),
         SNOW = textureLoc(4, 0),
@@ -68,6 +86,31 @@ namespace cube {
         LEFT = 4u << BIT_FACE_OFFSET,
         BOTTOM = 5u << BIT_FACE_OFFSET
     };
+    
+    
+    /**
+     * Class of material of a face. Each one is drawn by its own variant of the cube program, so
+     * that the per-material branches are resolved at compile time.
+     */
+    enum Material : GLubyte {
+        MATERIAL_OPAQUE,     /**< Fully opaque, drawn with face culling. */
+        MATERIAL_ALPHA_TEST, /**< Transparent texels are discarded, drawn without blending (eg. leaves). */
+        MATERIAL_BLENDED,    /**< Translucent, drawn last, back to front (eg. water). */
+        MATERIAL_LAST = MATERIAL_BLENDED
+    };
+    
+    /** Number of material classes. */
+    static constexpr GLuint MATERIAL_COUNT = MATERIAL_LAST + 1;
+    
+    /**
+     * Return the class of material of a block.
+     */
+    static constexpr Material getMaterial(GLushort data) {
+        if (data & TRANSLUCENT) {
+            return MATERIAL_BLENDED;
+        }
+        return (data & ALPHA) ? MATERIAL_ALPHA_TEST : MATERIAL_OPAQUE;
+    }
 }
 
 #endif //OPENGL_CUBETYPE_HPP
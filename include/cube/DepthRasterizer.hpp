@@ -0,0 +1,73 @@
+#ifndef OPENGL_DEPTHRASTERIZER_HPP
+#define OPENGL_DEPTHRASTERIZER_HPP
+
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Software rasterizer drawing the depth of occluders into a low resolution buffer, so that
+     * bounding boxes can be tested against it before any GL call.
+     *
+     * It does not depend on GL, the same results are obtained whatever the driver. Depths are
+     * normalized device coordinates. Occluders write their farthest depth over each pixel, so
+     * they never appear nearer than they are. Their coverage is sampled at the center of pixels,
+     * tested boxes are enlarged by a pixel to make up for it.
+     */
+    class DepthRasterizer : public misc::INonCopyable {
+        
+        public:
+            static constexpr GLint WIDTH = 256; /**< Must be a multiple of 4, pixels are processed by 4. */
+            static constexpr GLint HEIGHT = 128;
+        
+        private:
+            /** A quad clipped by the near plane has at most 5 vertices. */
+            static constexpr GLint MAX_VERTICES = 5;
+            
+            std::vector<GLfloat> depth;
+            glm::mat4 viewProjection = glm::mat4(1.f);
+            
+            /**
+             * Clip a convex polygon given in clip space against the near plane.
+             *
+             * @return The number of vertices written to `clipped`.
+             */
+            static GLint clipNear(const glm::vec4 *polygon, GLint count, glm::vec4 *clipped);
+            
+            /**
+             * Draw a convex polygon given in clip space, in front of the near plane, if it is facing
+             * the camera (counter-clockwise).
+             */
+            void drawPolygon(const glm::vec4 *polygon, GLint count);
+        
+        public:
+            
+            DepthRasterizer();
+            
+            /**
+             * Clear the buffer and set the matrix used to project the next boxes.
+             */
+            void clear(const glm::mat4 &viewProjection);
+            
+            /**
+             * Draw the faces of a box, which must be entirely opaque.
+             */
+            void drawBox(const glm::vec3 &min, const glm::vec3 &max);
+            
+            /**
+             * Whether any part of a box may be seen through the drawn occluders.
+             *
+             * Boxes crossing the near plane are always visible, boxes out of the screen or behind
+             * the camera never are.
+             */
+            [[nodiscard]] bool isVisible(const glm::vec3 &min, const glm::vec3 &max) const;
+    };
+}
+
+#endif // OPENGL_DEPTHRASTERIZER_HPP
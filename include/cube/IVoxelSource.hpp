@@ -0,0 +1,27 @@
+#ifndef OPENGL_IVOXELSOURCE_HPP
+#define OPENGL_IVOXELSOURCE_HPP
+
+#include <glm/vec3.hpp>
+
+#include <cube/CubeData.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Read access to the cubes of the world, used by chunks to look past their borders when meshing.
+     */
+    class IVoxelSource {
+        
+        public:
+            
+            virtual ~IVoxelSource() = default;
+            
+            /**
+             * Return the cube at the given world position.
+             */
+            [[nodiscard]] virtual CubeData get(const glm::ivec3 &position) const = 0;
+    };
+}
+
+#endif // OPENGL_IVOXELSOURCE_HPP
@@ -0,0 +1,72 @@
+#ifndef OPENGL_OCCLUSIONQUERIES_HPP
+#define OPENGL_OCCLUSIONQUERIES_HPP
+
+#include <memory>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <misc/INonCopyable.hpp>
+#include <shader/Shader.hpp>
+#include <shader/uniform/Uniform.hpp>
+#include <cube/ChunkBuffer.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Issue hardware occlusion queries on the bounding box of chunks.
+     *
+     * Boxes are drawn after the visible opaque geometry, without writing color nor depth, so that
+     * a query tells whether the chunk could be seen through what is already drawn.
+     */
+    class OcclusionQueries : public misc::INonCopyable {
+        
+        private:
+            static constexpr GLuint VERTEX_ATTR_POSITION = 0;
+            /**
+             * Boxes are enlarged so that they are not hidden by the faces of their own chunk
+             * lying on their sides.
+             */
+            static constexpr GLfloat MARGIN = 0.1f;
+            /**
+             * Distance under which the camera is considered inside a box, boxes clipped by the
+             * near plane would be wrongly reported as hidden.
+             */
+            static constexpr GLfloat INSIDE_MARGIN = 1.f;
+            
+            std::unique_ptr<shader::Shader> shader;
+            shader::Uniform<glm::vec3> uChunkPosition;
+            GLuint vbo = 0;
+            GLuint vao = 0;
+        
+        public:
+            
+            OcclusionQueries();
+            
+            ~OcclusionQueries();
+            
+            /**
+             * Set the state used to draw the boxes, must be called before `query()`.
+             */
+            void begin() const;
+            
+            /**
+             * Restore the state changed by `begin()`.
+             */
+            void end() const;
+            
+            /**
+             * Draw the bounding box of the chunk at the given position inside its occlusion query.
+             */
+            void query(ChunkBuffer &buffer, const glm::vec3 &position) const;
+            
+            /**
+             * Whether the camera is inside (or too close to) the bounding box of the chunk at the
+             * given position, in which case the chunk must be considered visible.
+             */
+            [[nodiscard]] static bool contains(const glm::vec3 &position, const glm::vec3 &camera);
+    };
+}
+
+#endif // OPENGL_OCCLUSIONQUERIES_HPP
@@ -1,16 +1,22 @@
 #ifndef OPENGL_SUPERCHUNK_HPP
 #define OPENGL_SUPERCHUNK_HPP
 
+#include <memory>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include <cube/Chunk.hpp>
-#include <shader/Shader.hpp>
+#include <cube/IVoxelSource.hpp>
 #include <misc/INonCopyable.hpp>
-#include <app/Config.hpp>
 
 
 namespace cube {
     
+    struct SuperChunkMesh;
+    
+    
+    
     class SuperChunk : public misc::INonCopyable {
         
         public:
@@ -22,14 +28,24 @@ namespace cube {
             static constexpr GLint Y = Chunk::Y * CHUNK_Y;
             static constexpr GLint Z = Chunk::Z * CHUNK_Z;
             static constexpr GLint SIZE = CHUNK_SIZE * Chunk::SIZE;
-            
-            static_assert(app::Config::GEN_MAX_H <= Y);
+            static constexpr GLint OCCLUDER_SIZE = 8; /**< Width of the square of columns under an occluder. */
+            static constexpr GLint OCCLUDER_X = X / OCCLUDER_SIZE;
+            static constexpr GLint OCCLUDER_Z = Z / OCCLUDER_SIZE;
         
         private:
             Chunk chunks[CHUNK_X][CHUNK_Y][CHUNK_Z];
             glm::ivec3 position = { 0, 0, 0 };
             GLboolean modified = true;
             GLuint count = 0;
+            GLuint occludedCount = 0; /**< Number of face hidden by occlusion culling. */
+            GLuint64 meshBytes = 0;   /**< Bytes of the meshes of the chunks, kept until they are rebuilt. */
+            GLuint64 bufferBytes = 0; /**< Bytes of the faces uploaded to the GPU. */
+            std::shared_ptr<const SuperChunkMesh> mesh = nullptr; /**< Meshes of the last update. */
+            
+            /**
+             * Compute the height of the solid ground under each square of `OCCLUDER_SIZE` columns.
+             */
+            void computeOccluders(SuperChunkMesh &mesh) const;
         
         public:
             
@@ -41,16 +57,68 @@ namespace cube {
             
             ~SuperChunk() = default;
             
-            CubeData get(GLuint x, GLuint y, GLuint z);
+            /**
+             * Move the superchunk to the given position so that it can be generated again, keeping
+             * its storage. Its cubes are left as is until overwritten by the generator.
+             */
+            void reset(glm::ivec3 position);
+            
+            [[nodiscard]] CubeData get(GLuint x, GLuint y, GLuint z) const;
             
             void set(GLuint x, GLuint y, GLuint z, CubeData type);
             
             void touch();
             
-            GLuint update();
+            /**
+             * Rebuild the mesh of every modified chunk.
+             *
+             * @return The number of faces of the superchunk.
+             */
+            GLuint update(const IVoxelSource &world, GLboolean occlusionCulling);
+            
+            [[nodiscard]] const Chunk &getChunk(GLuint x, GLuint y, GLuint z) const;
+            
+            /**
+             * Return the meshes of the chunks as of the last call to `update()`, `nullptr` if the
+             * superchunk was never updated.
+             */
+            [[nodiscard]] const std::shared_ptr<const SuperChunkMesh> &getMesh() const;
             
-            GLuint render(bool alpha);
+            [[nodiscard]] glm::ivec3 getPosition() const;
+            
+            [[nodiscard]] GLuint getCount() const;
+            
+            [[nodiscard]] GLuint getOccludedCount() const;
+            
+            /**
+             * Return the bytes of the meshes of the chunks, as of the last call to `update()`.
+             */
+            [[nodiscard]] GLuint64 getMeshBytes() const;
+            
+            /**
+             * Return the bytes the faces of the superchunk use once uploaded to the GPU, as of the
+             * last call to `update()`.
+             */
+            [[nodiscard]] GLuint64 getBufferBytes() const;
     };
+    
+    
+    
+    /**
+     * Immutable snapshot of the meshes of a superchunk, can be shared with the render thread.
+     */
+    struct SuperChunkMesh {
+        glm::ivec3 position; /**< Position of the superchunk. */
+        GLuint count;        /**< Number of faces of the superchunk. */
+        /**
+         * Number of opaque blocks stacked from the bottom of every column of each square of
+         * `SuperChunk::OCCLUDER_SIZE` columns, the square is hidden behind a box this high.
+         */
+        GLushort occluders[SuperChunk::OCCLUDER_X][SuperChunk::OCCLUDER_Z];
+        std::shared_ptr<const ChunkMesh> chunks[SuperChunk::CHUNK_X][SuperChunk::CHUNK_Y][SuperChunk::CHUNK_Z];
+    };
+    
+    typedef std::vector<std::shared_ptr<const SuperChunkMesh>> SuperChunkMeshList;
 }
 
 #endif //OPENGL_SUPERCHUNK_HPP
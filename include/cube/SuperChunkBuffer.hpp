@@ -0,0 +1,133 @@
+#ifndef OPENGL_SUPERCHUNKBUFFER_HPP
+#define OPENGL_SUPERCHUNKBUFFER_HPP
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <misc/INonCopyable.hpp>
+#include <cube/ChunkBuffer.hpp>
+#include <cube/DepthRasterizer.hpp>
+#include <cube/OcclusionQueries.hpp>
+#include <cube/SuperChunk.hpp>
+#include <cube/VertexArrayPool.hpp>
+
+
+namespace cube {
+    
+    /**
+     * GPU copy of the meshes of the chunks of a superchunk.
+     */
+    class SuperChunkBuffer : public misc::INonCopyable {
+        
+        public:
+            
+            /**
+             * Chunk to draw, used to draw chunks of several superchunks in a given order.
+             */
+            struct ChunkDraw {
+                const ChunkBuffer *buffer;
+                glm::vec3 position;
+                GLfloat distance; /**< Squared distance between the center of the chunk and the camera. */
+            };
+        
+        private:
+            ChunkBuffer buffers[SuperChunk::CHUNK_X][SuperChunk::CHUNK_Y][SuperChunk::CHUNK_Z];
+            glm::ivec3 position;
+            GLuint count = 0;
+            GLboolean culled = false; /**< Whether the whole superchunk is hidden behind the occluders. */
+            GLuint64 update = 0;      /**< Last update of `cube::ChunkRenderer` publishing the superchunk. */
+            std::shared_ptr<const SuperChunkMesh> mesh = nullptr; /**< Last uploaded meshes. */
+        
+        public:
+            
+            explicit SuperChunkBuffer(glm::ivec3 position);
+            
+            /**
+             * Move the buffer to the superchunk at the given position, forgetting the uploaded
+             * meshes but keeping the GL objects of the chunks for the next upload.
+             */
+            void reset(glm::ivec3 position);
+            
+            /**
+             * Upload the meshes of the chunks that changed since the last upload.
+             *
+             * @param pool Buffers and vertex arrays of the chunks are taken from and released to
+             *             this pool.
+             */
+            void upload(const std::shared_ptr<const SuperChunkMesh> &mesh, VertexArrayPool &pool);
+            
+            /**
+             * Record that the superchunk was published by the given update.
+             */
+            void setUpdate(GLuint64 update);
+            
+            /**
+             * Return the last update publishing the superchunk, an older one means it was unloaded.
+             */
+            [[nodiscard]] GLuint64 getUpdate() const;
+            
+            /**
+             * Add the superchunk and its chunks drawn in the current frame to `app::Stats`.
+             */
+            void countRendered() const;
+            
+            /**
+             * Append the chunks having faces of the given material to `draws`.
+             */
+            void getDraws(Material material, const glm::vec3 &camera, std::vector<ChunkDraw> &draws) const;
+            
+            /**
+             * Read the available results of the occlusion queries of the chunks.
+             *
+             * @return The number of chunks hidden according to their last query.
+             */
+            GLuint readOcclusion();
+            
+            /**
+             * Consider every chunk visible, used when occlusion queries are disabled.
+             */
+            void resetOcclusion();
+            
+            /**
+             * Issue the occlusion queries of the chunks needing one in the given frame.
+             *
+             * @return The number of queries issued.
+             */
+            GLuint queryOcclusion(const OcclusionQueries &queries, const glm::vec3 &camera, GLuint64 frame);
+            
+            /**
+             * Draw the boxes under which the ground of the superchunk is solid.
+             */
+            void drawOccluders(DepthRasterizer &rasterizer) const;
+            
+            /**
+             * Cull the superchunk, or each of its chunks, if hidden behind the drawn occluders.
+             *
+             * @return The number of non-empty chunks culled.
+             */
+            GLuint cull(const DepthRasterizer &rasterizer);
+            
+            /**
+             * Consider every chunk unculled, used when software occlusion is disabled.
+             */
+            void resetCulling();
+            
+            /**
+             * Set whether every chunk is reachable from the camera.
+             */
+            void setReachable(GLboolean reachable);
+            
+            /**
+             * Return the number of non-empty chunks not reached by the last visibility walk.
+             */
+            [[nodiscard]] GLuint getUnreachableCount() const;
+            
+            [[nodiscard]] ChunkBuffer &getChunk(const glm::ivec3 &chunk);
+            
+            [[nodiscard]] glm::ivec3 getPosition() const;
+    };
+}
+
+#endif // OPENGL_SUPERCHUNKBUFFER_HPP
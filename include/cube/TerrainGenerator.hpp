@@ -0,0 +1,78 @@
+#ifndef OPENGL_TERRAINGENERATOR_HPP
+#define OPENGL_TERRAINGENERATOR_HPP
+
+#include <GL/glew.h>
+#include <glm/gtc/noise.hpp>
+
+#include <misc/INonCopyable.hpp>
+#include <misc/Noise.hpp>
+#include <cube/SuperChunk.hpp>
+
+
+namespace cube {
+    
+    typedef misc::Noise<glm::vec2, float, glm::simplex> Noise2D;
+    typedef misc::Noise<glm::vec3, float, glm::simplex> Noise3D;
+    
+    
+    
+    /**
+     * Procedurally fill superchunks with terrain, biomes and trees.
+     *
+     * Noises are seeded from `effolkronium::random_static` when the generator is constructed.
+     */
+    class TerrainGenerator : public misc::INonCopyable {
+        
+        public:
+            /** Minimum height when procedurally generating a chunk. */
+            static constexpr GLubyte MIN_H = 128;
+            /** Maximum height when procedurally generating a chunk. */
+            static constexpr GLubyte MAX_H = 192;
+            static constexpr GLubyte CARVING_H = MIN_H + 30;
+            static constexpr GLubyte INTERVAL_H = MAX_H - MIN_H;
+            static constexpr GLubyte WATER_LEVEL = MIN_H + 22;
+            
+            static_assert(MIN_H < MAX_H);
+            static_assert(MAX_H <= SuperChunk::Y);
+        
+        private:
+            Noise2D temperatureNoise;
+            Noise3D carvingNoise;
+            Noise2D heightNoise;
+        
+        public:
+            
+            TerrainGenerator();
+            
+            [[nodiscard]] static CubeData getBiome(GLuint height, GLfloat temperature);
+            
+            /**
+             * First stage of the generation, fill each column with stone up to the height given by
+             * the height noise.
+             */
+            void shape(SuperChunk &chunk) const;
+            
+            /**
+             * Second stage of the generation, carve caves and overhangs with the 3D noise.
+             */
+            void carve(SuperChunk &chunk) const;
+            
+            /**
+             * Third stage of the generation, replace the top of each column according to its biome.
+             */
+            void paint(SuperChunk &chunk) const;
+            
+            /**
+             * Last stage of the generation, randomly plant trees and cactus on the floor.
+             */
+            static void plant(SuperChunk &chunk);
+            
+            /**
+             * Generate the given superchunk at its position, running every stage in order. Every
+             * cube is overwritten, a recycled superchunk does not need to be cleared first.
+             */
+            void generate(SuperChunk &chunk) const;
+    };
+}
+
+#endif // OPENGL_TERRAINGENERATOR_HPP
@@ -0,0 +1,51 @@
+#ifndef OPENGL_VERTEXARRAYPOOL_HPP
+#define OPENGL_VERTEXARRAYPOOL_HPP
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Buffers and vertex arrays released by the chunks, handed to the next chunks needing one
+     * instead of creating new GL objects.
+     *
+     * The vertex arrays keep the attributes set by `cube::ChunkBuffer`, the storage of their
+     * buffer is freed when released and allocated again by the next upload. The owner calls
+     * `trim()` to delete those it does not expect to reuse.
+     */
+    class VertexArrayPool : public misc::INonCopyable {
+        
+        private:
+            std::vector<GLuint> vbos;
+            std::vector<GLuint> vaos; /**< Vertex array of the buffer at the same index. */
+        
+        public:
+            
+            VertexArrayPool() = default;
+            
+            ~VertexArrayPool();
+            
+            /**
+             * Take a buffer and its vertex array from the pool.
+             *
+             * @return Whether the pool was not empty, `vbo` and `vao` being left untouched otherwise.
+             */
+            bool acquire(GLuint &vbo, GLuint &vao);
+            
+            void release(GLuint vbo, GLuint vao);
+            
+            /**
+             * Delete the buffers and vertex arrays beyond the first `size` of the pool.
+             */
+            void trim(GLuint size);
+            
+            [[nodiscard]] GLuint getSize() const;
+    };
+}
+
+#endif // OPENGL_VERTEXARRAYPOOL_HPP
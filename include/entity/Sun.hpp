@@ -2,6 +2,7 @@
 #define OPENGL_SUN_HPP
 
 #include <shader/Shader.hpp>
+#include <shader/uniform/Uniform.hpp>
 #include <app/Config.hpp>
 
 
@@ -57,7 +58,9 @@ namespace entity {
                 { 1,  -1, 1 },
             };
             std::unique_ptr<shader::Shader> shader;
+            shader::Uniform<glm::mat4> uModel;
             glm::vec3 position;
+            glm::mat4 model = glm::mat4(1.f); /**< Place the cube around the camera. */
             GLuint vbo;
             GLuint vao;
         
@@ -67,6 +70,9 @@ namespace entity {
             
             ~Sun();
             
+            /**
+             * Move the sun according to the time of day and the camera of the current frame.
+             */
             GLuint update();
             
             GLuint render();
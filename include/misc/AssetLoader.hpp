@@ -0,0 +1,65 @@
+#ifndef OPENGL_ASSETLOADER_HPP
+#define OPENGL_ASSETLOADER_HPP
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <misc/ISingleton.hpp>
+#include <misc/DiskCache.hpp>
+#include <misc/Image.hpp>
+
+
+namespace misc {
+    
+    /**
+     * Load images, decoding them on worker threads and caching the decoded pixels on disk.
+     *
+     * Cached images are keyed by the hash of their PNG file and memory-mapped, so a PNG is only
+     * inflated again when it changes.
+     */
+    class AssetLoader : public ISingleton {
+        
+        public:
+            static constexpr char CACHE_MAGIC[4] = { 'M', 'C', 'T', 'X' };
+            static constexpr GLuint CACHE_VERSION = 1;
+        
+        private:
+            /** Header of a cached image, followed by `width * height` RGBA8 pixels. */
+            struct CacheHeader {
+                char magic[4];
+                GLuint version;
+                GLuint width;
+                GLuint height;
+            };
+            
+            DiskCache cache = DiskCache("../cache/texture", ".tex");
+            
+            AssetLoader() = default;
+        
+        public:
+            
+            static AssetLoader *getInstance();
+            
+            /**
+             * Load an image, from the cache if possible, otherwise by decoding the PNG and
+             * storing the result in the cache.
+             */
+            [[nodiscard]] Image *loadImage(const std::string &path) const;
+            
+            /**
+             * Same as `loadImage()`, but on another thread.
+             */
+            [[nodiscard]] std::future<std::unique_ptr<Image>> loadImageAsync(const std::string &path) const;
+            
+            /**
+             * Load several images in parallel, returned in the same order as `paths`.
+             */
+            [[nodiscard]] std::vector<std::unique_ptr<Image>> loadImages(
+                const std::vector<std::string> &paths
+            ) const;
+    };
+}
+
+#endif // OPENGL_ASSETLOADER_HPP
@@ -0,0 +1,50 @@
+#ifndef OPENGL_DISKCACHE_HPP
+#define OPENGL_DISKCACHE_HPP
+
+#include <memory>
+#include <string>
+#include <cstddef>
+
+#include <GL/glew.h>
+
+#include <misc/MappedFile.hpp>
+
+
+namespace misc {
+    
+    /**
+     * Directory of binary blobs indexed by a 64 bits key (usually a `misc::Hash`).
+     *
+     * A blob is made of a fixed header followed by a payload. Writing is atomic, a
+     * partially written blob is never visible to readers.
+     */
+    class DiskCache {
+        
+        private:
+            std::string directory;
+            std::string extension;
+        
+        public:
+            
+            DiskCache(const std::string &directory, const std::string &extension);
+            
+            [[nodiscard]] std::string getPath(GLuint64 key) const;
+            
+            /**
+             * Map the blob corresponding to the given key.
+             *
+             * @return The mapped blob, or nullptr if the key is not in the cache.
+             */
+            [[nodiscard]] std::unique_ptr<MappedFile> map(GLuint64 key) const;
+            
+            /**
+             * Store a blob, replacing any existing one with the same key.
+             *
+             * @return Whether the blob could be written, a failure is not fatal.
+             */
+            bool write(GLuint64 key, const void *header, std::size_t headerSize, const void *payload,
+                       std::size_t payloadSize) const;
+    };
+}
+
+#endif // OPENGL_DISKCACHE_HPP
@@ -0,0 +1,34 @@
+#ifndef OPENGL_HASH_HPP
+#define OPENGL_HASH_HPP
+
+#include <string>
+#include <cstddef>
+
+#include <GL/glew.h>
+
+
+namespace misc {
+    
+    /**
+     * 64 bits FNV-1a hash, used to key on-disk caches.
+     *
+     * Not cryptographic, only meant to detect that a file or a source changed.
+     */
+    class Hash {
+        
+        public:
+            static constexpr GLuint64 OFFSET_BASIS = 14695981039346656037ull;
+            static constexpr GLuint64 PRIME = 1099511628211ull;
+            
+            Hash() = delete;
+            
+            [[nodiscard]] static GLuint64 fnv1a(const void *data, std::size_t size,
+                                                GLuint64 hash = OFFSET_BASIS);
+            
+            [[nodiscard]] static GLuint64 fnv1a(const std::string &data, GLuint64 hash = OFFSET_BASIS);
+            
+            [[nodiscard]] static std::string toHex(GLuint64 hash);
+    };
+}
+
+#endif // OPENGL_HASH_HPP
@@ -5,33 +5,66 @@
 #include <vector>
 
 #include <GL/glew.h>
-#include <glm/vec4.hpp>
 
 #include <misc/INonCopyable.hpp>
+#include <misc/MappedFile.hpp>
 
 
 namespace misc {
     
+    /**
+     * Image stored as tightly packed 8-bit RGBA pixels, ready to be uploaded with
+     * GL_RGBA / GL_UNSIGNED_BYTE.
+     *
+     * Pixels are either owned by the image, or read from a memory-mapped cache blob.
+     */
     class Image : public INonCopyable {
         
+        public:
+            static constexpr GLuint CHANNELS = 4; /**< Number of bytes per pixel. */
+        
         private:
             GLuint width;
             GLuint height;
-            std::vector<glm::vec4> pixels;
+            std::vector<GLubyte> pixels;
+            std::unique_ptr<MappedFile> mapping = nullptr;
+            GLubyte *data;
         
         public:
             
-            Image(GLuint width, GLuint height, std::vector<glm::vec4> t_pixels);
+            Image(GLuint width, GLuint height, std::vector<GLubyte> t_pixels);
+            
+            /**
+             * Create an image whose pixels start at `offset` in the given mapped file.
+             */
+            Image(GLuint width, GLuint height, std::unique_ptr<MappedFile> mapping, std::size_t offset);
             
             static Image *loadPNG(const std::string &path);
             
+            /**
+             * Decode a PNG already read in memory, `path` is only used in error messages.
+             */
+            static Image *loadPNG(const std::vector<GLubyte> &encoded, const std::string &path);
+            
+            void savePNG(const std::string &path) const;
+            
+            /**
+             * Copy a rectangular area of this image into a new image.
+             */
+            [[nodiscard]] Image *crop(GLuint x, GLuint y, GLuint width, GLuint height) const;
+            
+            /**
+             * Create a copy of this image resized to the given dimension, using nearest filtering.
+             */
+            [[nodiscard]] Image *resize(GLuint width, GLuint height) const;
+            
             [[nodiscard]] GLuint getWidth() const;
             
             [[nodiscard]] GLuint getHeight() const;
             
-            [[nodiscard]] const glm::vec4 *getPixels() const;
+            [[nodiscard]] const GLubyte *getPixels() const;
             
-            [[nodiscard]] glm::vec4 *getPixels();
+            [[nodiscard]] GLubyte *getPixels();
     };
 }
 
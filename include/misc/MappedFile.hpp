@@ -0,0 +1,35 @@
+#ifndef OPENGL_MAPPEDFILE_HPP
+#define OPENGL_MAPPEDFILE_HPP
+
+#include <string>
+#include <cstddef>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace misc {
+    
+    /**
+     * Read-only view of a whole file mapped in memory.
+     *
+     * The mapping is private: writing through `getData()` never modifies the file.
+     */
+    class MappedFile : public INonCopyable {
+        
+        private:
+            void *data = nullptr;
+            std::size_t size = 0;
+        
+        public:
+            
+            explicit MappedFile(const std::string &path);
+            
+            ~MappedFile();
+            
+            [[nodiscard]] void *getData() const;
+            
+            [[nodiscard]] std::size_t getSize() const;
+    };
+}
+
+#endif // OPENGL_MAPPEDFILE_HPP
@@ -47,7 +47,7 @@ namespace misc {
             }
             
             
-            PRECISION operator()(T x) {
+            PRECISION operator()(T x) const {
                 PRECISION value = 0.f;
                 PRECISION freq = this->frequency;
                 PRECISION ampl = this->amplitude;
@@ -65,7 +65,7 @@ namespace misc {
             }
             
             
-            PRECISION operator()(T x, PRECISION oldMin, PRECISION oldMax, PRECISION newMin, PRECISION newMax) {
+            PRECISION operator()(T x, PRECISION oldMin, PRECISION oldMax, PRECISION newMin, PRECISION newMax) const {
                 PRECISION value = (*this)(x);
                 
                 PRECISION oldRange = (oldMax - oldMin);
@@ -0,0 +1,42 @@
+#ifndef OPENGL_STOPWATCH_HPP
+#define OPENGL_STOPWATCH_HPP
+
+#include <chrono>
+#include <string>
+
+#include <GL/glew.h>
+
+
+namespace misc {
+    
+    /**
+     * Measure and print the duration of consecutive phases, e.g. during startup.
+     */
+    class Stopwatch {
+        
+        private:
+            std::string name;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::time_point last;
+        
+        public:
+            
+            explicit Stopwatch(const std::string &name);
+            
+            /**
+             * Print the time elapsed since the previous lap (or the creation of the stopwatch).
+             *
+             * @return The duration of the phase in milliseconds.
+             */
+            GLdouble lap(const std::string &phase);
+            
+            /**
+             * Print the time elapsed since the creation of the stopwatch.
+             *
+             * @return The total duration in milliseconds.
+             */
+            GLdouble total();
+    };
+}
+
+#endif // OPENGL_STOPWATCH_HPP
@@ -0,0 +1,91 @@
+#ifndef OPENGL_TRACE_HPP
+#define OPENGL_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <GL/glew.h>
+#include <glm/vec3.hpp>
+
+#include <misc/INonCopyable.hpp>
+
+
+/**
+ * Scope macros recording trace events, compiled out unless MASTERCRAFT_TRACE is defined
+ * (CMake option of the same name).
+ *
+ * `name` must be a string literal, or any string outliving the program.
+ */
+#ifdef MASTERCRAFT_TRACE
+    #define TRACE_CONCAT_IMPL(a, b) a##b
+    #define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+    #define TRACE_SCOPE(name) misc::TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+    #define TRACE_SCOPE_POS(name, position) \
+        misc::TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, position)
+#else
+    #define TRACE_SCOPE(name) static_cast<void>(0)
+    #define TRACE_SCOPE_POS(name, position) static_cast<void>(0)
+#endif
+
+
+namespace misc {
+    
+    /**
+     * Collect complete events ("X" phase) in per-thread ring buffers and export them as Chrome
+     * trace-event JSON, which can be opened by Perfetto or chrome://tracing.
+     *
+     * Recording is lock-free: each thread only writes in its own buffer, publishing events with
+     * an atomic index. The dump may miss events being overwritten at that moment, which is
+     * acceptable for a debugging tool.
+     */
+    class Trace {
+        
+        public:
+            static constexpr GLuint CAPACITY = 1u << 16; /**< Events kept per thread. */
+#ifdef MASTERCRAFT_TRACE
+            static constexpr GLboolean ENABLED = true;
+#else
+            static constexpr GLboolean ENABLED = false;
+#endif
+            
+            struct Event {
+                const char *name;
+                GLint64 start;    /**< In microseconds since the start of the program. */
+                GLint64 duration; /**< In microseconds. */
+                glm::ivec3 position;
+                GLboolean hasPosition;
+            };
+            
+            Trace() = delete;
+            
+            [[nodiscard]] static GLint64 now();
+            
+            static void record(const Event &event);
+            
+            /**
+             * Write every recorded event to `path`.
+             *
+             * @return The number of events written.
+             */
+            static GLuint64 dump(const std::string &path);
+    };
+    
+    
+    
+    class TraceScope : public INonCopyable {
+        
+        private:
+            Trace::Event event;
+        
+        public:
+            
+            explicit TraceScope(const char *name);
+            
+            TraceScope(const char *name, const glm::ivec3 &position);
+            
+            ~TraceScope();
+    };
+}
+
+#endif // OPENGL_TRACE_HPP
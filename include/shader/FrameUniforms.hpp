@@ -0,0 +1,44 @@
+#ifndef OPENGL_FRAMEUNIFORMS_HPP
+#define OPENGL_FRAMEUNIFORMS_HPP
+
+#include <cstddef>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+
+namespace shader {
+    
+    /**
+     * Values shared by every program through the `Frame` uniform block (see `shader/frame.glsl`),
+     * written once per frame.
+     *
+     * Members mirror the std140 layout of the block: matrices and vectors first, as they are
+     * aligned on 16 bytes, scalars last.
+     */
+    struct FrameUniforms {
+        static constexpr GLuint BINDING = 0;               /**< Binding point of the block. */
+        static constexpr const GLchar *BLOCK = "Frame";    /**< Name of the block in GLSL. */
+        static constexpr const char *SOURCE = "../shader/frame.glsl";
+        
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProjection;
+        glm::mat4 skyboxViewProjection; /**< View-projection without the translation of the camera. */
+        glm::mat4 normal;
+        glm::vec4 lightPosition;        /**< In view space. */
+        glm::vec4 lightColor;
+        glm::vec4 skyColor;
+        GLfloat lightDirIntensity;
+        GLfloat lightAmbIntensity;
+        GLint verticalOffset;           /**< Frame of animated textures. */
+        GLint padding;                  /**< std140 rounds the size of a block up to 16 bytes. */
+    };
+    
+    static_assert(offsetof(FrameUniforms, lightPosition) == 320, "FrameUniforms does not match std140");
+    static_assert(offsetof(FrameUniforms, lightDirIntensity) == 368, "FrameUniforms does not match std140");
+    static_assert(offsetof(FrameUniforms, verticalOffset) == 376, "FrameUniforms does not match std140");
+    static_assert(sizeof(FrameUniforms) == 384, "FrameUniforms does not match std140");
+}
+
+#endif // OPENGL_FRAMEUNIFORMS_HPP
@@ -0,0 +1,60 @@
+#ifndef OPENGL_FRAMEBUFFER_HPP
+#define OPENGL_FRAMEBUFFER_HPP
+
+#include <memory>
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+#include <misc/Image.hpp>
+
+
+namespace shader {
+    
+    /**
+     * Offscreen render target made of an RGBA8 color buffer and a 24 bits depth buffer.
+     */
+    class Framebuffer : public misc::INonCopyable {
+        
+        private:
+            GLuint fbo = 0;
+            GLuint color = 0;
+            GLuint depth = 0;
+            GLsizei width;
+            GLsizei height;
+        
+        public:
+            
+            Framebuffer(GLsizei width, GLsizei height);
+            
+            ~Framebuffer();
+            
+            /**
+             * Bind the framebuffer as both the draw and read target, and set the viewport to its size.
+             */
+            void bind() const;
+            
+            void unbind() const;
+            
+            /**
+             * Stretch the color buffer over `target` with a linear filter, and leave `target` bound
+             * with the viewport set to its size.
+             *
+             * @param target Framebuffer to copy to, the default framebuffer if null.
+             * @param width Width of the target.
+             * @param height Height of the target.
+             */
+            void blit(const Framebuffer *target, GLsizei width, GLsizei height) const;
+            
+            /**
+             * Read back the color buffer, top row first.
+             */
+            [[nodiscard]] misc::Image *read() const;
+            
+            [[nodiscard]] GLsizei getWidth() const;
+            
+            [[nodiscard]] GLsizei getHeight() const;
+    };
+}
+
+#endif // OPENGL_FRAMEBUFFER_HPP
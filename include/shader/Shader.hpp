@@ -13,6 +13,31 @@
 namespace shader {
     
     class Shader : public misc::INonCopyable {
+        public:
+            static constexpr char CACHE_MAGIC[4] = { 'M', 'C', 'S', 'H' };
+            static constexpr GLuint CACHE_VERSION = 1;
+        
+        private:
+            /** Header of a cached program, followed by `length` bytes of driver specific binary. */
+            struct CacheHeader {
+                char magic[4];
+                GLuint version;
+                GLenum format;
+                GLuint length;
+            };
+            
+            static GLboolean binaryCache; /**< Whether linked programs are cached on disk. */
+            
+            GLboolean loadBinary(GLuint64 key);
+            
+            void storeBinary(GLuint64 key) const;
+            
+            /**
+             * Bind the `Frame` uniform block of the program, if declared, to
+             * `FrameUniforms::BINDING`.
+             */
+            void bindFrameBlock() const;
+        
         protected:
             std::unordered_map<std::string, std::shared_ptr<IUniform>> uniforms;
             GLuint programId;
@@ -23,14 +48,33 @@ namespace shader {
             
             Shader() = default;
             
-            Shader(const std::string &vsPath, const std::string &fsPath);
+            /**
+             * @param defines Names defined in both stages right after the version directive,
+             *                used to compile variants of the same sources.
+             */
+            Shader(const std::string &vsPath, const std::string &fsPath, const std::vector<std::string> &defines = {});
             
             ~Shader();
             
+            /**
+             * Enable or disable the on-disk cache of linked programs, enabled by default. The first
+             * shader disables it if the driver cannot retrieve program binaries.
+             *
+             * Must be called before any shader is created.
+             */
+            static void setBinaryCache(GLboolean enabled);
+            
             void addUniform(const std::string &name, UniformType type);
             
             void loadUniform(const std::string &name, const void *value) const;
             
+            /**
+             * Return the location of a uniform variable, or -1 (with a warning) if it is not active.
+             *
+             * Used by `shader::Uniform` to resolve its location once.
+             */
+            [[nodiscard]] GLint getUniformLocation(const GLchar *name) const;
+            
             void use() const;
             
             void stop() const;
@@ -3,6 +3,7 @@
 
 #include <shader/Shader.hpp>
 #include <shader/Texture.hpp>
+#include <shader/TextureArray.hpp>
 
 
 namespace shader {
@@ -15,10 +16,13 @@ namespace shader {
             
             ShaderTexture() = default;
             
-            ShaderTexture(const std::string &vsFile, const std::string &fsFile);
+            ShaderTexture(const std::string &vsFile, const std::string &fsFile,
+                          const std::vector<std::string> &defines = {});
             
             void bindTexture(const Texture &texture) const;
             
+            void bindTexture(const TextureArray &texture) const;
+            
             void unbindTexture() const;
     };
 }
@@ -0,0 +1,39 @@
+#ifndef OPENGL_TEXTUREARRAY_HPP
+#define OPENGL_TEXTUREARRAY_HPP
+
+#include <memory>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+#include <misc/Image.hpp>
+
+
+namespace shader {
+    
+    /**
+     * Mipmapped GL_TEXTURE_2D_ARRAY, every layer must have the same dimension.
+     */
+    class TextureArray : public misc::INonCopyable {
+        private:
+            GLuint textureId = 0;
+            GLuint layers = 0;
+        
+        public:
+            
+            TextureArray() = default;
+            
+            explicit TextureArray(const std::vector<std::unique_ptr<misc::Image>> &layers);
+            
+            ~TextureArray();
+            
+            void bind() const;
+            
+            void unbind() const;
+            
+            [[nodiscard]] GLuint getLayerCount() const;
+    };
+}
+
+#endif // OPENGL_TEXTUREARRAY_HPP
@@ -0,0 +1,34 @@
+#ifndef OPENGL_UNIFORMBUFFER_HPP
+#define OPENGL_UNIFORMBUFFER_HPP
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace shader {
+    
+    /**
+     * Buffer backing a uniform block, bound to a binding point so that every program declaring
+     * the block reads the same values.
+     */
+    class UniformBuffer : public misc::INonCopyable {
+        
+        private:
+            GLuint ubo = 0;
+            GLsizeiptr size;
+        
+        public:
+            
+            UniformBuffer(GLuint binding, GLsizeiptr size);
+            
+            ~UniformBuffer();
+            
+            /**
+             * Replace the content of the buffer by the `size` bytes pointed by `data`.
+             */
+            void update(const void *data) const;
+    };
+}
+
+#endif // OPENGL_UNIFORMBUFFER_HPP
@@ -0,0 +1,62 @@
+#ifndef OPENGL_UNIFORM_HPP
+#define OPENGL_UNIFORM_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <shader/Shader.hpp>
+
+
+namespace shader {
+    
+    /**
+     * Handle to a uniform variable of type `T`, its location being resolved once when the handle
+     * is created.
+     *
+     * Unlike `Shader::loadUniform()`, loading a value does not look the uniform up by name, and is
+     * a single `glUniform*` call. The program must be in use.
+     */
+    template<typename T>
+    class Uniform {
+        
+        private:
+            GLint location = -1;
+        
+        public:
+            
+            Uniform() = default;
+            
+            Uniform(const Shader &shader, const GLchar *name) :
+                location(shader.getUniformLocation(name)) {
+            }
+            
+            void load(const T &value) const;
+    };
+    
+    
+    template<>
+    inline void Uniform<GLfloat>::load(const GLfloat &value) const {
+        glUniform1f(this->location, value);
+    }
+    
+    
+    template<>
+    inline void Uniform<GLint>::load(const GLint &value) const {
+        glUniform1i(this->location, value);
+    }
+    
+    
+    template<>
+    inline void Uniform<glm::vec3>::load(const glm::vec3 &value) const {
+        glUniform3fv(this->location, 1, glm::value_ptr(value));
+    }
+    
+    
+    template<>
+    inline void Uniform<glm::mat4>::load(const glm::mat4 &value) const {
+        glUniformMatrix4fv(this->location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+}
+
+#endif // OPENGL_UNIFORM_HPP
@@ -11,6 +11,15 @@ namespace tool {
     
     class Camera : public misc::INonCopyable {
         
+        public:
+            
+            /** Position and orientation of the camera. */
+            struct Pose {
+                glm::vec3 position;
+                GLfloat pitch;
+                GLfloat yaw;
+            };
+        
         private:
             glm::mat4 projMatrix;  /**< Projection matrix of the camera */
             glm::vec3 position;    /**< Position of the camera */
@@ -20,6 +29,16 @@ namespace tool {
             glm::vec3 upVector;    /**< Vector used to move on Y axis */
             glm::vec3 frontVector; /**< Vector used to move on Z axis */
             
+            glm::vec3 previousPosition; /**< Position at the start of the current tick */
+            GLfloat previousPitch;      /**< Pitch at the start of the current tick */
+            GLfloat previousYaw;        /**< Yaw at the start of the current tick */
+            glm::vec3 renderPosition;   /**< Position interpolated for the current frame */
+            glm::vec3 renderFront;      /**< Front vector interpolated for the current frame */
+            glm::mat4 viewMatrix;       /**< View matrix interpolated for the current frame */
+            
+            static void computeDirectionVectors(GLfloat pitch, GLfloat yaw, glm::vec3 &front,
+                                                glm::vec3 &left, glm::vec3 &up);
+            
             void computeDirectionVectors();
         
         public:
@@ -44,6 +63,50 @@ namespace tool {
             
             void setAngle(GLfloat pitch, GLfloat yaw);
             
+            [[nodiscard]] GLfloat getPitch() const;
+            
+            [[nodiscard]] GLfloat getYaw() const;
+            
+            /**
+             * Save the current pose as the pose of the previous tick, must be called before the
+             * simulation moves the camera.
+             */
+            void beginTick();
+            
+            /**
+             * Forget the previous pose, so that the next frames do not interpolate from it.
+             */
+            void snap();
+            
+            [[nodiscard]] Pose getPose() const;
+            
+            [[nodiscard]] Pose getPreviousPose() const;
+            
+            /**
+             * Replace both the previous and the current pose, e.g. with the poses simulated by
+             * another camera.
+             */
+            void setPoses(const Pose &previous, const Pose &current);
+            
+            /**
+             * Rotate both the current and the previous pose, so that the rotation is entirely
+             * visible in the next frame. Used to look around once per frame, between ticks.
+             */
+            void look(GLfloat left, GLfloat up);
+            
+            /**
+             * Compute the pose rendered in the current frame, between the previous pose (`alpha` = 0)
+             * and the current one (`alpha` = 1).
+             */
+            void interpolate(GLfloat alpha);
+            
+            [[nodiscard]] glm::vec3 getRenderPosition() const;
+            
+            [[nodiscard]] glm::vec3 getRenderFrontVector() const;
+            
+            /**
+             * Return the view matrix of the pose computed by the last call to `interpolate()`.
+             */
             [[nodiscard]] glm::mat4 getViewMatrix() const;
             
             void setProjMatrix(float fov, int width, int height);
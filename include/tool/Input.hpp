@@ -52,7 +52,7 @@ namespace tool {
         private:
             std::unordered_map<SDL_Scancode, InputState> keys; /** InputState of every keyboard's keys. */
             std::unordered_map<uint8_t, InputState> buttons;   /** InputState of every mouse's buttons. */
-            glm::vec2 mouseMotion = { 0, 0 }; /** Relative motion of the mouse. */
+            glm::vec2 mouseMotion = { 0, 0 }; /** Relative motion of the mouse since it was last taken. */
             glm::vec2 wheelMotion = { 0, 0 }; /** Relative motion of the wheel. */
             GLboolean end = false; /** Whether SDL_QUIT has occured. */
             
@@ -95,6 +95,14 @@ namespace tool {
             
             [[nodiscard]] glm::vec2 getRelativeMotion() const;
             
+            /**
+             * Return the relative motion of the mouse accumulated since the last call, and clear it.
+             *
+             * Unlike other states, the motion is not cleared by `reset()`, so it can be consumed
+             * at another rate than the ticks.
+             */
+            glm::vec2 takeRelativeMotion();
+            
             [[nodiscard]] glm::vec2 getWheelMotion() const;
     };
 }
@@ -0,0 +1,49 @@
+#ifndef OPENGL_QUERYRING_HPP
+#define OPENGL_QUERYRING_HPP
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <misc/INonCopyable.hpp>
+
+
+namespace tool {
+    
+    /**
+     * Ring of query objects of the same target (e.g. GL_TIME_ELAPSED).
+     *
+     * Results are read back a few frames later, only once available, so that measuring never
+     * stalls the pipeline. If every query of the ring is still in flight, the measurement is
+     * skipped.
+     */
+    class QueryRing : public misc::INonCopyable {
+        
+        private:
+            GLenum target;
+            std::vector<GLuint> queries;
+            std::vector<GLboolean> pending;
+            GLuint head = 0;   /**< Next query to begin. */
+            GLuint tail = 0;   /**< Oldest query in flight. */
+            GLboolean active = false;
+        
+        public:
+            
+            explicit QueryRing(GLenum target, GLuint size = 4);
+            
+            ~QueryRing();
+            
+            void begin();
+            
+            void end();
+            
+            /**
+             * Retrieve the result of the oldest query in flight, if available.
+             *
+             * @return Whether a result was written into `result`.
+             */
+            GLboolean poll(GLuint64 &result);
+    };
+}
+
+#endif // OPENGL_QUERYRING_HPP
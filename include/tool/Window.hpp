@@ -4,6 +4,8 @@
 #include <SDL_video.h>
 #include <SDL_events.h>
 
+#include <glm/vec2.hpp>
+
 #include <tool/Camera.hpp>
 #include <misc/ISingleton.hpp>
 
@@ -21,6 +23,14 @@ namespace tool {
             
             explicit Window(const char *title, int32_t width, int32_t height, uint32_t flags = 0);
             
+            /**
+             * Create a hidden window, only used to own an OpenGL context rendering offscreen.
+             *
+             * When no display is available, SDL's offscreen video driver (EGL) is used, unless
+             * SDL_VIDEODRIVER says otherwise.
+             */
+            static Window *headless(const char *title, int32_t width, int32_t height);
+            
             ~Window();
             
             void refresh();
@@ -30,6 +40,11 @@ namespace tool {
             [[nodiscard]] SDL_GLContext getContext() const;
             
             [[nodiscard]] SDL_DisplayMode getDisplayMode() const;
+            
+            /**
+             * Size of the drawable, in pixels.
+             */
+            [[nodiscard]] glm::ivec2 getSize() const;
     };
 }
 
@@ -3,36 +3,22 @@
 in vec3 vPosition;
 in vec3 vNormal;
 in vec2 vTexture;
-in vec2 vTextureOffset;
-flat in int vFace;
-flat in int vAlpha;
-flat in int vAnimated;
+flat in int vLayer;
 
-uniform sampler2D uTexture;
-uniform vec3 uLightPosition;
-uniform vec3 uLightColor;
-uniform float uLightDirIntensity;
-uniform float uLightAmbIntensity;
-uniform int uVerticalOffset;
+#{{ FRAME }}
+
+uniform mediump sampler2DArray uTexture;
 
 out vec4 fFragColor;
 
 
 /**
- * Compute the color of the fragment according to uTexture.
+ * Compute the color of the fragment according to the layer of uTexture selected by the vertex shader.
  *
  * @return The computed color.
  */
 vec4 computeTextureColor() {
-    vec2 textureCoordinates = vec2((vTexture.x + vTextureOffset.x) / 8.f, 0);
-
-    if (vAnimated != 0) {
-        textureCoordinates.y = (vTexture.y + float(uVerticalOffset)) / 64.f;
-    } else {
-        textureCoordinates.y = (vTexture.y + (vTextureOffset.y * 6.f) + float(vFace)) / 32.f;
-    }
-
-    return texture(uTexture, textureCoordinates);
+    return texture(uTexture, vec3(vTexture, float(vLayer)));
 }
 
 /**
@@ -41,7 +27,7 @@ vec4 computeTextureColor() {
  * @return The computed diffuse lighting.
  */
 vec3 computeDiffuseLighting() {
-    vec3 lightDirection = normalize(uLightPosition - vPosition);
+    vec3 lightDirection = normalize(uLightPosition.xyz - vPosition);
     vec3 diffuse = vec3(max(dot(vNormal, lightDirection), 0.0f));
     return diffuse * uLightDirIntensity;
 }
@@ -49,13 +35,17 @@ vec3 computeDiffuseLighting() {
 
 void main() {
     vec4 textureColor = computeTextureColor();
+#ifdef ALPHA_TEST
+    // Only alpha tested materials (eg. leaves) have fully transparent texels, other variants
+    // never discard so that early depth testing stays enabled
     if (textureColor.w == 0.f) {
         discard;
     }
+#endif
 
     vec3 diffuse = computeDiffuseLighting();
     vec3 ambient = vec3(uLightAmbIntensity);
-    vec3 light =  (diffuse + ambient) * uLightColor;
+    vec3 light =  (diffuse + ambient) * uLightColor.rgb;
 
     fFragColor = vec4(
         min(1.f, light.x),
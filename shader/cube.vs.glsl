@@ -5,18 +5,14 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexture;
 layout (location = 3) in int aData;
 
-uniform mat4 uMV;
-uniform mat4 uMVP;
-uniform mat4 uNormal;
+#{{ FRAME }}
+
 uniform vec3 uChunkPosition;
 
 out vec3 vPosition;
 out vec3 vNormal;
 out vec2 vTexture;
-out vec2 vTextureOffset;
-flat out int vFace;
-flat out int vAlpha;
-flat out int vAnimated;
+flat out int vLayer;
 
 
 // Use to extract the bits 0b00000000.0000xxxx of aData, representing the X offset of the texture of the cube (&).
@@ -28,27 +24,30 @@ const int TEXTURE_Y = 240;
 // Use to extract the bits 0b00000xxx.00000000 of aData, representing the face of the cube (& >> 8).
 const int FACE = 1792;
 
-// Use to extract the bits 0b0000x000.00000000 of aData, telling if the cube has an alpha channel (&).
-const int ALPHA = 1 << 11;
+// The alpha (0b0000x000.00000000) and animated (0b000x0000.00000000) bits of aData are not decoded, they
+// are constant for each variant of the program: faces are split by material when meshed, and drawn with
+// OPAQUE, ALPHA_TEST or BLENDED (with ANIMATED) defined, see cube::Material.
 
-// Use to extract the bits 0b000x0000.00000000 of aData, telling if the cube has an animated texture (&).
-const int ANIMATED = 1 << 12;
+// Number of texture columns in the atlas, see cube::ATLAS_COLUMNS.
+const int ATLAS_COLUMNS = 8;
 
-// Use to extract the bits 0b00Xx0000.00000000 of aData, telling the texture use an overlay according to the top of the cube (&).
-const int TOP_OVERLAY = 1 << 13;
+// Layer of the first animation frame in the texture array, see cube::ATLAS_ANIMATED_LAYER.
+const int ATLAS_ANIMATED_LAYER = 192;
 
 
 void main(){
     vec4 vertexPosition = vec4(aPosition + uChunkPosition, 1);
 
-    vPosition = vec3(uMV * vertexPosition);
+    vPosition = vec3(uView * vertexPosition);
     vNormal = vec3(uNormal * vec4(aNormal, 0));
     vTexture = aTexture;
-    vTextureOffset = vec2(aData & TEXTURE_X, (aData & TEXTURE_Y) >> 4 );
-    vFace = (aData & FACE) >> 8;
-    vAlpha = aData & ALPHA;
-    vAnimated = aData & ANIMATED;
 
-    gl_Position = uMVP * vertexPosition;
+#ifdef ANIMATED
+    vLayer = ATLAS_ANIMATED_LAYER + uVerticalOffset;
+#else
+    vLayer = (aData & TEXTURE_X) + ATLAS_COLUMNS * ((((aData & TEXTURE_Y) >> 4) * 6) + ((aData & FACE) >> 8));
+#endif
+
+    gl_Position = uViewProjection * vertexPosition;
 }
 
@@ -0,0 +1,14 @@
+// Values shared by every program, written once per frame, see shader::FrameUniforms.
+layout (std140) uniform Frame {
+    highp mat4 uView;
+    highp mat4 uProjection;
+    highp mat4 uViewProjection;
+    highp mat4 uSkyboxViewProjection;
+    highp mat4 uNormal;
+    highp vec4 uLightPosition;
+    highp vec4 uLightColor;
+    highp vec4 uSkyColor;
+    highp float uLightDirIntensity;
+    highp float uLightAmbIntensity;
+    highp int uVerticalOffset;
+};
@@ -0,0 +1,8 @@
+#{{ HEADER }}
+
+out vec4 fFragColor;
+
+// Color writes are disabled, only the depth test matters
+void main() {
+    fFragColor = vec4(1.);
+}
@@ -0,0 +1,11 @@
+#{{ HEADER }}
+
+layout (location = 0) in vec3 aPosition;
+
+#{{ FRAME }}
+
+uniform vec3 uChunkPosition;
+
+void main(){
+    gl_Position = uViewProjection * vec4(aPosition + uChunkPosition, 1);
+}
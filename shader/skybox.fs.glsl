@@ -2,12 +2,13 @@
 
 in vec3 vTexture;
 
+#{{ FRAME }}
+
 uniform samplerCube uCubemap;
-uniform vec3 uSkyColor;
 
 out vec4 fFragColor;
 
 
 void main() {
-    fFragColor = vec4(vec3(1.f) - (texture(uCubemap, vTexture).xyz * (vec3(1.f) - uSkyColor)), 1);
+    fFragColor = vec4(vec3(1.f) - (texture(uCubemap, vTexture).xyz * (vec3(1.f) - uSkyColor.rgb)), 1);
 }
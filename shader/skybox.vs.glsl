@@ -2,12 +2,13 @@
 
 layout (location = 0) in vec3 aPosition;
 
-uniform mat4 uMVP;
+#{{ FRAME }}
 
 out vec3 vTexture;
 
 
 void main() {
     vTexture = aPosition;
-    gl_Position = uMVP * vec4(aPosition, 1.0);
+    // Always at the far plane, so that only the pixels left uncovered by the terrain are shaded
+    gl_Position = (uSkyboxViewProjection * vec4(aPosition, 1.0)).xyww;
 }
@@ -2,9 +2,12 @@
 
 layout (location = 0) in vec3 aPosition;
 
-uniform mat4 uMVP;
+#{{ FRAME }}
+
+uniform mat4 uModel;
 
 void main(){
-    gl_Position = uMVP * vec4(aPosition, 1);
+    // At the far plane like the skybox, it is drawn in front of it with a less or equal depth test
+    gl_Position = (uViewProjection * uModel * vec4(aPosition, 1)).xyww;
 }
 
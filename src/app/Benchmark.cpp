@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <glm/geometric.hpp>
+
+#include <app/Benchmark.hpp>
+#include <app/Config.hpp>
+#include <app/Stats.hpp>
+#include <cube/TerrainGenerator.hpp>
+
+
+namespace app {
+    
+    /**
+     * Escape a string to be written between the quotes of a JSON string.
+     */
+    static std::string escapeJson(const std::string &value) {
+        std::ostringstream ss;
+        
+        for (char c : value) {
+            switch (c) {
+                case '"':
+                    ss << "\\\"";
+                    break;
+                case '\\':
+                    ss << "\\\\";
+                    break;
+                case '\n':
+                    ss << "\\n";
+                    break;
+                case '\r':
+                    ss << "\\r";
+                    break;
+                case '\t':
+                    ss << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                           << static_cast<int>(static_cast<unsigned char>(c)) << std::dec << std::setfill(' ');
+                    }
+                    else {
+                        ss << c;
+                    }
+            }
+        }
+        
+        return ss.str();
+    }
+    
+    
+    Benchmark::Benchmark(const std::string &t_name, GLuint t_seed, GLint t_distanceView,
+                         GLuint t_ticks, GLdouble t_hitchMs, const std::string &t_output) :
+        name(t_name), seed(t_seed), distanceView(t_distanceView), ticks(t_ticks), hitchMs(t_hitchMs),
+        output(t_output) {
+        if (t_name == "straight") {
+            this->path = BENCHMARK_STRAIGHT;
+        }
+        else if (t_name == "spiral") {
+            this->path = BENCHMARK_SPIRAL;
+        }
+        else if (t_name == "teleport") {
+            this->path = BENCHMARK_TELEPORT;
+        }
+        else {
+            this->path = BENCHMARK_FILE;
+            this->keyframes = loadKeyframes(t_name);
+        }
+        
+        this->frameTimes.reserve(t_ticks * 4);
+    }
+    
+    
+    std::vector<Benchmark::Keyframe> Benchmark::loadKeyframes(const std::string &path) {
+        std::ifstream file = std::ifstream(path);
+        std::vector<Keyframe> keyframes;
+        Keyframe keyframe {};
+        
+        if (!file) {
+            throw std::runtime_error("Error: Unknown benchmark path '" + path + "'");
+        }
+        
+        while (file >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z
+                    >> keyframe.pitch >> keyframe.yaw) {
+            keyframes.push_back(keyframe);
+        }
+        if (keyframes.size() < 2) {
+            throw std::runtime_error("Error: Benchmark path '" + path + "' needs at least 2 keyframes");
+        }
+        
+        return keyframes;
+    }
+    
+    
+    void Benchmark::appendKeyframe(const std::string &path, const tool::Camera &camera) {
+        std::ofstream file = std::ofstream(path, std::ios::app);
+        glm::vec3 position = camera.getPosition();
+        
+        file << position.x << " " << position.y << " " << position.z << " " << camera.getPitch()
+             << " " << camera.getYaw() << std::endl;
+    }
+    
+    
+    Benchmark::Keyframe Benchmark::getKeyframe(GLuint t_tick) const {
+        static constexpr GLfloat altitude = cube::TerrainGenerator::MAX_H + 8;
+        GLfloat t = static_cast<GLfloat>(t_tick);
+        
+        switch (this->path) {
+            case BENCHMARK_STRAIGHT:
+                return { { 0.f, altitude, -t * SPEED }, -0.3f, static_cast<GLfloat>(M_PI) };
+            
+            case BENCHMARK_SPIRAL: {
+                // The radius grows by one SuperChunk per turn, the speed along the curve is constant
+                GLfloat growth = cube::SuperChunk::X / (2.f * static_cast<GLfloat>(M_PI));
+                GLfloat angle = std::sqrt(2.f * t * SPEED / growth);
+                GLfloat radius = growth * angle;
+                glm::vec3 tangent = {
+                    growth * std::cos(angle) - radius * std::sin(angle), 0,
+                    growth * std::sin(angle) + radius * std::cos(angle)
+                };
+                return {
+                    { radius * std::cos(angle), altitude, radius * std::sin(angle) }, -0.3f,
+                    std::atan2(tangent.x, tangent.z)
+                };
+            }
+            
+            case BENCHMARK_TELEPORT: {
+                GLfloat jump = static_cast<GLfloat>(t_tick / TELEPORT_INTERVAL);
+                GLfloat yaw = static_cast<GLfloat>(t_tick % TELEPORT_INTERVAL) / TELEPORT_INTERVAL
+                              * 2.f * static_cast<GLfloat>(M_PI);
+                return { { jump * 1024.f, altitude, jump * -768.f }, -0.5f, yaw };
+            }
+            
+            case BENCHMARK_FILE: {
+                GLfloat progress = t / static_cast<GLfloat>(std::max(this->ticks, 1u))
+                                   * static_cast<GLfloat>(this->keyframes.size() - 1);
+                GLuint index = std::min(
+                    static_cast<GLuint>(progress), static_cast<GLuint>(this->keyframes.size() - 2)
+                );
+                GLfloat alpha = std::min(progress - static_cast<GLfloat>(index), 1.f);
+                const Keyframe &a = this->keyframes[index];
+                const Keyframe &b = this->keyframes[index + 1];
+                return {
+                    a.position + (b.position - a.position) * alpha, a.pitch + (b.pitch - a.pitch) * alpha,
+                    a.yaw + (b.yaw - a.yaw) * alpha
+                };
+            }
+        }
+        
+        return { glm::vec3(0), 0, 0 };
+    }
+    
+    
+    GLuint Benchmark::getSeed() const {
+        return this->seed;
+    }
+    
+    
+    GLint Benchmark::getDistanceView() const {
+        return this->distanceView;
+    }
+    
+    
+    GLboolean Benchmark::update(tool::Camera &camera) {
+        if (this->tick >= this->ticks) {
+            return false;
+        }
+        
+        Keyframe keyframe = this->getKeyframe(this->tick++);
+        GLboolean jump = glm::distance(camera.getPosition(), keyframe.position) > SPEED * 4;
+        camera.setPosition(keyframe.position);
+        camera.setAngle(keyframe.pitch, keyframe.yaw);
+        if (jump) { // Do not interpolate frames across a teleport
+            camera.snap();
+        }
+        
+        return true;
+    }
+    
+    
+    void Benchmark::frame(GLuint faces, GLfloat latency) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        
+        if (!this->tick) { // Not started yet
+            return;
+        }
+        if (!this->started) {
+            this->superChunksAtStart = Stats::getInstance()->g_superchunk;
+            this->start = now;
+            this->lastFrame = now;
+            this->started = true;
+            return;
+        }
+        
+        this->frameTimes.push_back(std::chrono::duration<GLfloat, std::milli>(now - this->lastFrame).count());
+        this->latencies.push_back(latency);
+        this->facesDrawn += faces;
+        this->lastFrame = now;
+    }
+    
+    
+    void Benchmark::report() const {
+        std::vector<GLfloat> sorted = this->frameTimes;
+        std::vector<GLfloat> latencies = this->latencies;
+        GLuint64 frames = sorted.size();
+        GLdouble duration = std::chrono::duration<GLdouble, std::milli>(this->lastFrame - this->start).count();
+        GLdouble mean = 0;
+        GLuint hitches = 0;
+        std::stringstream ss;
+        
+        std::sort(sorted.begin(), sorted.end());
+        std::sort(latencies.begin(), latencies.end());
+        for (GLfloat ms : sorted) {
+            mean += ms;
+            hitches += ms > this->hitchMs;
+        }
+        mean = frames ? mean / static_cast<GLdouble>(frames) : 0;
+        
+        auto percentileOf = [](const std::vector<GLfloat> &values, GLdouble p) {
+            return values.empty() ? 0.f : values[static_cast<GLuint64>(p * static_cast<GLdouble>(values.size() - 1))];
+        };
+        auto percentile = [&](GLdouble p) { return percentileOf(sorted, p); };
+        
+        ss << std::fixed << std::setprecision(3)
+           << "{\n"
+           << "  \"path\": \"" << escapeJson(this->name) << "\",\n"
+           << "  \"seed\": " << this->seed << ",\n"
+           << "  \"distance_view\": " << this->distanceView << ",\n"
+           << "  \"ticks\": " << this->ticks << ",\n"
+           << "  \"gpu\": \"" << escapeJson(Config::getInstance()->getGPUInfo()) << "\",\n"
+           << "  \"frames\": " << frames << ",\n"
+           << "  \"duration_ms\": " << duration << ",\n"
+           << "  \"fps\": " << (duration > 0 ? static_cast<GLdouble>(frames) / duration * 1000. : 0) << ",\n"
+           << "  \"frame_ms\": {\n"
+           << "    \"mean\": " << mean << ",\n"
+           << "    \"p50\": " << percentile(0.50) << ",\n"
+           << "    \"p95\": " << percentile(0.95) << ",\n"
+           << "    \"p99\": " << percentile(0.99) << ",\n"
+           << "    \"max\": " << (sorted.empty() ? 0.f : sorted.back()) << "\n"
+           << "  },\n"
+           << "  \"interpolation\": " << (Config::getInstance()->getInterpolation() ? "true" : "false") << ",\n"
+           << "  \"input_latency_ms\": {\n"
+           << "    \"p50\": " << percentileOf(latencies, 0.50) << ",\n"
+           << "    \"p99\": " << percentileOf(latencies, 0.99) << ",\n"
+           << "    \"max\": " << (latencies.empty() ? 0.f : latencies.back()) << "\n"
+           << "  },\n"
+           << "  \"hitch_threshold_ms\": " << this->hitchMs << ",\n"
+           << "  \"hitches\": " << hitches << ",\n"
+           << "  \"superchunks_generated\": " << Stats::getInstance()->g_superchunk - this->superChunksAtStart
+           << ",\n"
+           << "  \"faces_drawn\": " << this->facesDrawn << ",\n"
+           << "  \"faces_per_frame\": "
+           << (frames ? static_cast<GLdouble>(this->facesDrawn) / static_cast<GLdouble>(frames) : 0) << "\n"
+           << "}\n";
+        
+        std::cout << ss.str();
+        if (!this->output.empty()) {
+            std::ofstream file = std::ofstream(this->output, std::ios::trunc);
+            file << ss.str();
+            if (!file) {
+                std::cerr << "Error: Could not write benchmark report to '" << this->output << "'" << std::endl;
+            }
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <iterator>
 
 #include <SDL_mouse.h>
+#include <SDL_video.h>
 #include <libcpuid.h>
 
 #include <app/Config.hpp>
@@ -39,8 +40,9 @@ namespace app {
         this->setFaceCulling(true);
         
         SDL_DisplayMode display = window.getDisplayMode();
-        this->width = display.w;
-        this->height = display.h;
+        glm::ivec2 size = window.getSize();
+        this->width = size.x;
+        this->height = size.y;
         GLuint fps = static_cast<GLuint>(window.getDisplayMode().refresh_rate);
         this->vSyncFramerate = fps ? fps : 60;
         this->setFramerate(FRAMERATE_VSYNC);
@@ -134,6 +136,11 @@ namespace app {
     }
     
     
+    [[maybe_unused]] GLboolean Config::getVSync() const {
+        return this->vSync;
+    }
+    
+    
     [[maybe_unused]] Framerate Config::getFramerateOpt() const {
         return this->framerateOpt;
     }
@@ -171,6 +178,17 @@ namespace app {
     
     [[maybe_unused]] void Config::setFramerate(Framerate framerate) {
         this->framerateOpt = framerate;
+        this->vSync = false;
+        
+        // Let the driver synchronize the buffer swap with the display when possible
+        if (SDL_GL_GetCurrentContext()) {
+            this->vSync = (
+                framerate == Framerate::FRAMERATE_VSYNC && !SDL_GL_SetSwapInterval(1)
+            );
+            if (!this->vSync) {
+                SDL_GL_SetSwapInterval(0);
+            }
+        }
         
         switch (framerate) {
             case Framerate::FRAMERATE_30:
@@ -203,7 +221,10 @@ namespace app {
                 break;
             case Framerate::FRAMERATE_VSYNC:
                 this->framerate = this->vSyncFramerate;
-                this->usPerFrame = static_cast<GLuint>(1. / this->framerate * 1e6);
+                // The swap blocks until the next refresh, fall back to a timer if it is not supported
+                this->usPerFrame = this->vSync || !this->framerate ? 0 : static_cast<GLuint>(
+                    1. / this->framerate * 1e6
+                );
                 break;
             case Framerate::FRAMERATE_UNCAPPED:
                 this->framerate = 0;
@@ -254,8 +275,8 @@ namespace app {
     [[maybe_unused]] void Config::setFov(GLfloat fov, const tool::Window &window,
                                          tool::Camera &camera) {
         this->fov = fov;
-        SDL_DisplayMode display = window.getDisplayMode();
-        camera.setProjMatrix(fov, display.w, display.h);
+        glm::ivec2 size = window.getSize();
+        camera.setProjMatrix(fov, size.x, size.y);
     }
     
     
@@ -269,6 +290,41 @@ namespace app {
     }
     
     
+    [[maybe_unused]] GLboolean Config::getAdaptiveDistance() const {
+        return adaptiveDistance;
+    }
+    
+    
+    [[maybe_unused]] void Config::setAdaptiveDistance(GLboolean adaptiveDistance) {
+        this->adaptiveDistance = adaptiveDistance;
+    }
+    
+    
+    [[maybe_unused]] void Config::switchAdaptiveDistance() {
+        this->adaptiveDistance = !this->adaptiveDistance;
+    }
+    
+    
+    [[maybe_unused]] GLfloat Config::getRenderScale() const {
+        return renderScale;
+    }
+    
+    
+    [[maybe_unused]] void Config::setRenderScale(GLfloat renderScale) {
+        this->renderScale = renderScale;
+    }
+    
+    
+    [[maybe_unused]] GLuint Config::getMemoryBudget() const {
+        return memoryBudget;
+    }
+    
+    
+    [[maybe_unused]] void Config::setMemoryBudget(GLuint memoryBudget) {
+        this->memoryBudget = memoryBudget;
+    }
+    
+    
     [[maybe_unused]] GLboolean Config::getFreeMouse() const {
         return freeMouse;
     }
@@ -315,6 +371,51 @@ namespace app {
     }
     
     
+    [[maybe_unused]] GLboolean Config::getOcclusionQueries() const {
+        return occlusionQueries;
+    }
+    
+    
+    [[maybe_unused]] void Config::setOcclusionQueries(GLboolean occlusionQueries) {
+        this->occlusionQueries = occlusionQueries;
+    }
+    
+    
+    [[maybe_unused]] void Config::switchOcclusionQueries() {
+        this->occlusionQueries = !this->occlusionQueries;
+    }
+    
+    
+    [[maybe_unused]] GLboolean Config::getSoftwareOcclusion() const {
+        return softwareOcclusion;
+    }
+    
+    
+    [[maybe_unused]] void Config::setSoftwareOcclusion(GLboolean softwareOcclusion) {
+        this->softwareOcclusion = softwareOcclusion;
+    }
+    
+    
+    [[maybe_unused]] void Config::switchSoftwareOcclusion() {
+        this->softwareOcclusion = !this->softwareOcclusion;
+    }
+    
+    
+    [[maybe_unused]] GLboolean Config::getCaveCulling() const {
+        return caveCulling;
+    }
+    
+    
+    [[maybe_unused]] void Config::setCaveCulling(GLboolean caveCulling) {
+        this->caveCulling = caveCulling;
+    }
+    
+    
+    [[maybe_unused]] void Config::switchCaveCulling() {
+        this->caveCulling = !this->caveCulling;
+    }
+    
+    
     [[maybe_unused]] GLboolean Config::getFrustumCulling() const {
         return frustumCulling;
     }
@@ -330,6 +431,21 @@ namespace app {
     }
     
     
+    [[maybe_unused]] GLboolean Config::getInterpolation() const {
+        return interpolation;
+    }
+    
+    
+    [[maybe_unused]] void Config::setInterpolation(GLboolean interpolation) {
+        this->interpolation = interpolation;
+    }
+    
+    
+    [[maybe_unused]] void Config::switchInterpolation() {
+        this->interpolation = !this->interpolation;
+    }
+    
+    
     [[maybe_unused]] GLboolean Config::getDebug() const {
         return debug;
     }
@@ -1,4 +1,6 @@
+#include <cfloat>
 #include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <iomanip>
 #include <memory>
@@ -9,6 +11,9 @@
 #include <app/Engine.hpp>
 #include <app/Config.hpp>
 #include <app/Stats.hpp>
+#include <app/Profiler.hpp>
+#include <misc/Stopwatch.hpp>
+#include <misc/Trace.hpp>
 #include <algorithm>
 
 
@@ -21,61 +26,81 @@ namespace app {
     
     
     void Engine::init() {
-        this->window = std::make_unique<tool::Window>("OpenGL");
+        misc::Stopwatch stopwatch = misc::Stopwatch("startup");
+        this->startTime = std::chrono::steady_clock::now();
+        
+        if (this->headlessSize.x > 0) {
+            this->window = std::unique_ptr<tool::Window>(
+                tool::Window::headless("OpenGL", this->headlessSize.x, this->headlessSize.y)
+            );
+        }
+        else {
+            this->window = std::make_unique<tool::Window>("OpenGL");
+        }
+        stopwatch.lap("window");
         
         GLenum glewInitError = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        // GLEW built for GLX reports this error on EGL contexts, after having loaded the entry points
+        if (glewInitError == GLEW_ERROR_NO_GLX_DISPLAY && this->headlessSize.x > 0) {
+            glewInitError = GLEW_OK;
+        }
+#endif
         if (GLEW_OK != glewInitError) {
             throw std::runtime_error(
                 reinterpret_cast<const char *>(glewGetErrorString(glewInitError)));
         }
+        stopwatch.lap("glew");
+        Profiler::getInstance()->init();
         
-        this->lastTick = std::chrono::steady_clock::now();
+        this->scheduler = std::make_unique<FrameScheduler>(Config::TICK_PER_SEC);
         this->camera = std::make_unique<tool::Camera>();
         this->camera->moveForward(-5);
-        this->camera->moveUp(Config::GEN_MAX_H + 1);
+        this->camera->moveUp(cube::TerrainGenerator::MAX_H + 1);
+        this->camera->snap();
         this->input = std::make_unique<tool::Input>();
         this->imGui = std::make_unique<tool::ImGuiHandler>(this->window->getWindow(),
                                                            this->window->getContext());
         Config::getInstance()->init(*this->window, *this->camera);
+        this->governor = std::make_unique<Governor>(
+            Config::getInstance()->getDistanceView(), Config::getInstance()->getRenderScale()
+        );
+        if (this->benchmark) {
+            Config::getInstance()->setFramerate(FRAMERATE_UNCAPPED);
+        }
+        if (this->headlessSize.x > 0) {
+            this->framebuffer = std::make_unique<shader::Framebuffer>(this->headlessSize.x, this->headlessSize.y);
+            Config::getInstance()->setDebug(false);
+        }
+        stopwatch.lap("config & imgui");
         
         glEnable(GL_BLEND);
         glEnable(GL_DEPTH_TEST);
         glEnable(GL_CULL_FACE);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        SDL_SetRelativeMouseMode(SDL_TRUE);
+        if (!this->framebuffer) {
+            SDL_SetRelativeMouseMode(SDL_TRUE);
+        }
         
         this->world = std::make_unique<app::World>();
+        stopwatch.lap("world");
+        this->simulation = std::make_unique<app::Simulation>(this->camera->getPose(), this->benchmark.get());
+        this->control();
+        this->simulation->start();
+        stopwatch.total();
+        
+        this->scheduler->reset();
     }
     
     
-    GLboolean Engine::tick() {
-        Config *config = Config::getInstance();
-        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-        GLint64 duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - this->lastTick
-        ).count();
-        
-        if (duration >= Config::MS_PER_TICK) {
-            this->lastTick = now;
-            this->tickCount++;
-            this->tickSecond = (this->tickSecond + 1) % Config::TICK_PER_SEC;
-            this->world->tickCycle = static_cast<GLfloat>(
-                static_cast<GLint>((this->world->tickCycle + 1))
-                % static_cast<GLint>(config->getTickPerDay())
-            );
-            return true;
-        }
-        
-        return false;
+    void Engine::setHeadless(GLint width, GLint height, const std::string &capture) {
+        this->headlessSize = { width, height };
+        this->capturePath = capture;
     }
     
     
-    void Engine::update() {
-        Config *config = Config::getInstance();
-        
-        GLfloat speed = config->getSpeed();
+    void Engine::pollEvents() {
         SDL_Event event;
-        this->input->reset();
         
         while (SDL_PollEvent(&event)) {
             switch (event.type) {
@@ -105,6 +130,15 @@ namespace app {
                     this->input->handleInput(event);
             }
         }
+    }
+    
+    
+    void Engine::control() {
+        Config *config = Config::getInstance();
+        Simulation::Controls controls;
+        std::chrono::steady_clock::time_point inputStart = std::chrono::steady_clock::now();
+        
+        this->pollEvents();
         
         // Close app
         if (this->input->ended() || this->input->isReleasedKey(SDL_SCANCODE_ESCAPE)) {
@@ -112,31 +146,20 @@ namespace app {
         }
         
         // Movements
-        if (this->input->isHeldKey(SDL_SCANCODE_A)) {
-            this->camera->moveLeft(speed);
-        }
-        if (this->input->isHeldKey(SDL_SCANCODE_D)) {
-            this->camera->moveLeft(-speed);
-        }
-        if (this->input->isHeldKey(SDL_SCANCODE_W)) {
-            this->camera->moveForward(speed);
-        }
-        if (this->input->isHeldKey(SDL_SCANCODE_S)) {
-            this->camera->moveForward(-speed);
-        }
-        if (this->input->isHeldKey(SDL_SCANCODE_SPACE)) {
-            this->camera->moveUp(speed);
-        }
-        if (this->input->isHeldKey(SDL_SCANCODE_LCTRL)) {
-            this->camera->moveUp(-speed);
-        }
-        
-        // Camera rotation
+        auto axis = [this](SDL_Scancode positive, SDL_Scancode negative) {
+            return static_cast<GLfloat>(this->input->isHeldKey(positive))
+                   - static_cast<GLfloat>(this->input->isHeldKey(negative));
+        };
+        controls.move = {
+            axis(SDL_SCANCODE_A, SDL_SCANCODE_D), axis(SDL_SCANCODE_SPACE, SDL_SCANCODE_LCTRL),
+            axis(SDL_SCANCODE_W, SDL_SCANCODE_S)
+        };
+        
+        // Look around, every frame to keep the latency low
+        glm::vec2 motion = this->input->takeRelativeMotion();
+        this->inputSample = std::chrono::steady_clock::now();
         if (!config->getFreeMouse()) {
-            glm::vec2 motion = this->input->getRelativeMotion();
-            GLfloat sensitivity = config->getMouseSensitivity();
-            this->camera->rotateLeft(-motion.x * sensitivity);
-            this->camera->rotateUp(-motion.y * sensitivity);
+            controls.look = -motion * config->getMouseSensitivity();
         }
         
         // Toggle free mouse
@@ -145,21 +168,48 @@ namespace app {
         }
         
         // Toggle day / night
-        if (this->input->isReleasedKey(SDL_SCANCODE_E)) {
-            if (this->world->tickCycle < config->getTickPerDay() / 2) {
-                this->world->tickCycle = config->getTickDuskEnd();
+        controls.switchDayNight = this->input->isReleasedKey(SDL_SCANCODE_E);
+        
+        // Toggle debug
+        if (this->input->isReleasedKey(SDL_SCANCODE_F1)) {
+            config->switchDebug();
+        }
+        
+        // Dump trace
+        if (this->input->isReleasedKey(SDL_SCANCODE_F2)) {
+            if (misc::Trace::ENABLED) {
+                std::string path = "trace_" + std::to_string(misc::Trace::now()) + ".json";
+                GLuint64 count = misc::Trace::dump(path);
+                std::cout << "Trace: " << count << " events written to '" << path << "'" << std::endl;
             }
             else {
-                this->world->tickCycle = config->getTickDawnEnd();
+                std::cout << "Trace: not available, build with -DMASTERCRAFT_TRACE=ON" << std::endl;
             }
         }
         
-        // Toggle debug
-        if (this->input->isReleasedKey(SDL_SCANCODE_F1)) {
-            config->switchDebug();
+        // Record a keyframe for benchmarks
+        if (this->input->isReleasedKey(SDL_SCANCODE_F3)) {
+            Benchmark::appendKeyframe("benchmark_path.txt", *this->camera);
+            std::cout << "Benchmark: keyframe appended to 'benchmark_path.txt'" << std::endl;
         }
         
-        this->world->update();
+        // Key transitions polled since the last frame have now been handled
+        this->input->reset();
+        
+        // The simulation reads a copy of the settings, they are modified by this thread at any time
+        controls.speed = config->getSpeed();
+        controls.distanceView = (
+            config->getAdaptiveDistance() ? this->governor->getDistanceView() : config->getDistanceView()
+        );
+        controls.memoryBudget = static_cast<GLuint64>(config->getMemoryBudget()) << 20;
+        controls.occlusionCulling = config->getOcclusionCulling();
+        this->simulation->control(controls);
+        
+        Profiler::getInstance()->addCpuTime(
+            PHASE_INPUT, std::chrono::duration<GLdouble, std::milli>(
+                std::chrono::steady_clock::now() - inputStart
+            ).count()
+        );
     }
     
     
@@ -173,7 +223,7 @@ namespace app {
         
         glm::mat4 MVMatrix = this->camera->getViewMatrix();
         glm::vec3 lightPos = glm::vec3(MVMatrix * glm::vec4(this->world->sun->getPosition(), 0));
-        glm::vec3 lightColor = config->getLightColor(this->world->tickCycle);
+        glm::vec3 lightColor = config->getLightColor(this->world->renderTickCycle);
         
         glm::vec3 dawnDuskSkyboxColor = config->getDawnDuskSkyboxCol();
         glm::vec3 daySkyboxColor = config->getDaySkyboxCol();
@@ -190,7 +240,7 @@ namespace app {
         GLfloat dawnDuskLighAmbIntensity = config->getDawnDuskLightAmbIntensity();
         GLfloat nightLighAmbIntensity = config->getNightLightAmbIntensity();
         GLfloat dayLighAmbIntensity = config->getDayLightAmbIntensity();
-    
+        
         
         GLuint dawnStart = static_cast<GLuint>(config->getTickDawnStart());
         GLuint dawn = static_cast<GLuint>(config->getTickDawn());
@@ -201,12 +251,19 @@ namespace app {
         glm::ivec3 dawnArray = {dawnStart, dawn, dawnEnd};
         glm::ivec3 duskArray = {duskStart, dusk, duskEnd};
         
-        GLfloat lightDirIntensity = config->getLightDirIntensity(this->world->tickCycle);
-        GLfloat lightAmbIntensity = config->getLightAmbIntensity(this->world->tickCycle);
+        GLfloat lightDirIntensity = config->getLightDirIntensity(this->world->renderTickCycle);
+        GLfloat lightAmbIntensity = config->getLightAmbIntensity(this->world->renderTickCycle);
         
         float speed = config->getSpeed();
         bool faceCulling = config->getFaceCulling();
         bool occlusionCulling = config->getOcclusionCulling();
+        bool occlusionQueries = config->getOcclusionQueries();
+        bool softwareOcclusion = config->getSoftwareOcclusion();
+        bool caveCulling = config->getCaveCulling();
+        bool interpolation = config->getInterpolation();
+        bool adaptiveDistance = config->getAdaptiveDistance();
+        float renderScale = config->getRenderScale();
+        int memoryBudget = static_cast<int>(config->getMemoryBudget());
         
         std::stringstream ss;
         
@@ -222,12 +279,24 @@ namespace app {
             "Your driver / OpenGL settings may lock you on VSYNC.\n"
             "VSYNC's value can differs from the one display, based on your driver / OpenGL settings."
         );
-    
+        ImGui::Text("Idle: %.1f %%", static_cast<double>(stats->idle));
+        ImGui::SameLine();
+        tool::ImGuiHandler::HelpMarker(
+            "Share of the time the main loop spent sleeping until the next frame or tick.\n"
+            "Always 0 when uncapped, or when VSYNC is handled by the driver."
+        );
+        ImGui::Text("Input latency: %.2f ms", static_cast<double>(stats->inputLatency));
+        ImGui::SameLine();
+        tool::ImGuiHandler::HelpMarker(
+            "Time between the last mouse sample used by the camera and the presentation of the frame.\n"
+            "The mouse is sampled every frame, independently of the ticks."
+        );
+        
         ImGui::PushItemWidth(200);
         
         // Tick
-        GLint tickSecond = static_cast<GLint>(this->tickSecond);
-        GLint tickCycle = static_cast<GLint>(this->world->tickCycle);
+        GLint tickSecond = static_cast<GLint>(this->world->packet->tick % Config::TICK_PER_SEC);
+        GLint tickCycle = static_cast<GLint>(this->world->packet->tickCycle);
         ImGui::Text("Tick:");
         ImGui::SameLine(90);
         ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.6f);
@@ -315,6 +384,8 @@ namespace app {
             ImGui::Unindent();
             ImGui::BulletText("E: To switch between day and night.");
             ImGui::BulletText("F1 : Displays / closes the debug menu.");
+            ImGui::BulletText("F2 : Dump a trace (requires MASTERCRAFT_TRACE).");
+            ImGui::BulletText("F3 : Record a keyframe for benchmark paths.");
             ImGui::BulletText("LEFT ALT: Free / lock the mouse cursor.");
             ImGui::Dummy({ 0.0f, 3.0f });
             ImGui::Text("Freeing the cursor allows you to interact with this menu.");
@@ -360,6 +431,58 @@ namespace app {
                 ImGui::EndCombo();
             }
             
+            ImGui::Text("Adaptive Distance:");
+            ImGui::SameLine(160);
+            ImGui::Checkbox("##adaptiveDistanceSetting", &adaptiveDistance);
+            config->setAdaptiveDistance(adaptiveDistance);
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Lower the distance view and the render scale when frames or ticks take too long,\n"
+                "and raise them back up to the chosen values once there is room.\n"
+                "Has no effect when uncapped."
+            );
+            if (adaptiveDistance) {
+                ImGui::Text(
+                    "Governor: %d, scale %.2f, %s", this->governor->getDistanceView(),
+                    static_cast<double>(this->governor->getRenderScale()),
+                    Governor::getDecisionName(this->governor->getDecision())
+                );
+                ImGui::Text(
+                    "Frame: %.2f / %.2f ms, tick: %.2f / %.2f ms",
+                    static_cast<double>(this->governor->getFrameMs()),
+                    static_cast<double>(this->governor->getBudgetMs()),
+                    static_cast<double>(this->governor->getUpdateMs()),
+                    1000. / Config::TICK_PER_SEC
+                );
+            }
+            
+            // Render scale
+            ImGui::Text("Render Scale:");
+            ImGui::SameLine(160);
+            ImGui::SliderFloat("##renderScaleSetting", &renderScale, 0.25f, 1.f, "%.2f");
+            config->setRenderScale(renderScale);
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Render the world at a fraction of the resolution and stretch it over the window,\n"
+                "for GPUs bound by their fill rate. The debug menu keeps the full resolution.\n"
+                "With Adaptive Distance, this is the highest scale the governor may use."
+            );
+            
+            // Memory budget
+            ImGui::Text("Memory Budget:");
+            ImGui::SameLine(160);
+            ImGui::SliderInt("##memoryBudgetSetting", &memoryBudget, 0, 8192, "%d MiB");
+            config->setMemoryBudget(static_cast<GLuint>(memoryBudget));
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Memory the superchunks may use, counting their cubes, their meshes and their GPU buffers.\n"
+                "The farthest superchunks are unloaded to fit in it, whatever the distance view.\n"
+                "0 to disable."
+            );
+            if (this->world->packet->memoryBound) {
+                ImGui::Text("Memory bound: %u superchunks fit in the budget", this->world->packet->wanted);
+            }
+            
             // Speed
             ImGui::Text("Speed:");
             ImGui::SameLine(160);
@@ -373,6 +496,16 @@ namespace app {
             ImGui::Checkbox("##faceCullingSetting", &faceCulling);
             config->setFaceCulling(faceCulling);
             
+            ImGui::Text("Interpolation:");
+            ImGui::SameLine(160);
+            ImGui::Checkbox("##interpolationSetting", &interpolation);
+            config->setInterpolation(interpolation);
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Interpolate the position of the camera and the time of day between ticks,\n"
+                "instead of rendering the state of the last tick."
+            );
+            
             ImGui::Text("Occlusion Culling:");
             ImGui::SameLine(160);
             ImGui::Checkbox("##occlusionCullingSetting", &occlusionCulling);
@@ -383,6 +516,36 @@ namespace app {
                 "May freeze the game. This settings only affect newly-loaded chunks."
             );
             
+            ImGui::Text("Occlusion Queries:");
+            ImGui::SameLine(160);
+            ImGui::Checkbox("##occlusionQueriesSetting", &occlusionQueries);
+            config->setOcclusionQueries(occlusionQueries);
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Ask the GPU whether the bounding box of each chunk is hidden by the terrain,\n"
+                "and skip hidden chunks."
+            );
+            
+            ImGui::Text("Software Occlusion:");
+            ImGui::SameLine(160);
+            ImGui::Checkbox("##softwareOcclusionSetting", &softwareOcclusion);
+            config->setSoftwareOcclusion(softwareOcclusion);
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Rasterize the solid ground on the CPU, and skip the chunks hidden behind it\n"
+                "before drawing anything."
+            );
+            
+            ImGui::Text("Cave Culling:");
+            ImGui::SameLine(160);
+            ImGui::Checkbox("##caveCullingSetting", &caveCulling);
+            config->setCaveCulling(caveCulling);
+            ImGui::SameLine();
+            tool::ImGuiHandler::HelpMarker(
+                "Skip the chunks that cannot be seen from the camera through air, water\n"
+                "or foliage, like caves sealed in the ground."
+            );
+            
             if (ImGui::CollapsingHeader("Skybox")) {
                 ImGui::Indent();
                 
@@ -521,6 +684,81 @@ namespace app {
                << static_cast<GLfloat>(stats->r_face) / static_cast<GLfloat>(stats->l_face) * 100
                << "%) rendered";
             ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Rendered : " << stats->r_superchunk << " superchunks, " << stats->r_chunk
+               << " chunks, " << stats->r_cube << " cubes";
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Occluded faces : " << stats->occludedFace;
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Occluded chunks : " << stats->occludedChunk << " (" << stats->occlusionQuery << " queries)";
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Culled chunks : " << stats->culledChunk;
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Sealed chunks : " << stats->sealedChunk;
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Frustum culled faces : " << stats->frustumCulledFace;
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "GL objects : " << stats->glObject << " (" << stats->g_glObject << " created in "
+               << stats->glObjectMs << " ms)";
+            ImGui::Text("%s", ss.str().c_str());
+            
+            ss.str(std::string());
+            ss << "Memory : " << (stats->voxelBytes >> 20) << " MiB voxels, " << (stats->meshBytes >> 20)
+               << " MiB meshes, " << (stats->bufferBytes >> 20) << " MiB GPU buffers";
+            ImGui::Text("%s", ss.str().c_str());
+            ImGui::Unindent();
+        }
+        
+        if (ImGui::CollapsingHeader("Profiler")) {
+            Profiler *profiler = Profiler::getInstance();
+            const GLfloat *history;
+            ProfilerPhase phase;
+            char overlay[64];
+            
+            ImGui::Indent();
+            for (GLuint i = 0; i < Profiler::PHASE_COUNT; i++) {
+                phase = static_cast<ProfilerPhase>(i);
+                ImGui::Text("%s", Profiler::getPhaseName(phase));
+                
+                history = profiler->getCpuHistory(phase);
+                std::snprintf(
+                    overlay, sizeof(overlay), "CPU p50 %.3f ms / p99 %.3f ms",
+                    Profiler::percentile(history, 0.5f), Profiler::percentile(history, 0.99f)
+                );
+                ImGui::PlotLines(
+                    (std::string("##cpu") + std::to_string(i)).c_str(), history, Profiler::HISTORY,
+                    static_cast<int>(profiler->getCpuOffset()), overlay, 0.f, FLT_MAX, { 0, 40 }
+                );
+                
+                if (profiler->hasGpuTime(phase)) {
+                    history = profiler->getGpuHistory(phase);
+                    std::snprintf(
+                        overlay, sizeof(overlay), "GPU p50 %.3f ms / p99 %.3f ms",
+                        Profiler::percentile(history, 0.5f), Profiler::percentile(history, 0.99f)
+                    );
+                    ImGui::PlotLines(
+                        (std::string("##gpu") + std::to_string(i)).c_str(), history, Profiler::HISTORY,
+                        static_cast<int>(profiler->getGpuOffset(phase)), overlay, 0.f, FLT_MAX, { 0, 40 }
+                    );
+                }
+                
+                if (profiler->hasFragments(phase)) {
+                    ImGui::Text("Fragments: %llu", static_cast<unsigned long long>(profiler->getFragments(phase)));
+                }
+            }
             ImGui::Unindent();
         }
         
@@ -556,39 +794,128 @@ namespace app {
     }
     
     
-    void Engine::_render() const {
+    void Engine::updateScene(GLint width, GLint height) {
+        Config *config = Config::getInstance();
+        GLfloat scale = config->getAdaptiveDistance() ? this->governor->getRenderScale() : config->getRenderScale();
+        GLsizei sceneWidth = std::max(1, static_cast<GLsizei>(static_cast<GLfloat>(width) * scale));
+        GLsizei sceneHeight = std::max(1, static_cast<GLsizei>(static_cast<GLfloat>(height) * scale));
+        
+        if (sceneWidth >= width && sceneHeight >= height) {
+            this->scene.reset();
+        }
+        else if (!this->scene || this->scene->getWidth() != sceneWidth || this->scene->getHeight() != sceneHeight) {
+            this->scene = std::make_unique<shader::Framebuffer>(sceneWidth, sceneHeight);
+        }
+    }
+    
+    
+    void Engine::_render() {
+        TRACE_SCOPE("Engine::render");
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        GLfloat alpha = 1.f;
+        glm::vec2 pendingLook;
+        
+        this->control();
+        this->world->packet = this->simulation->getPacket(pendingLook);
+        this->world->update();
+        
+        // The simulation stopped at the end of the benchmark's path
+        if (this->benchmark && this->world->packet->finished && this->running) {
+            this->benchmark->report();
+            this->running = false;
+        }
+        
+        if (Config::getInstance()->getInterpolation()) {
+            alpha = this->scheduler->getTickAlpha(this->world->packet->time);
+        }
+        this->camera->setPoses(this->world->packet->previousPose, this->world->packet->pose);
+        this->camera->look(pendingLook.x, pendingLook.y);
+        this->camera->interpolate(alpha);
+        this->world->interpolate(alpha);
+        
+        // The world is drawn at the render scale and stretched over the target, the overlay is not
+        GLint width = this->framebuffer ? this->framebuffer->getWidth() : Config::getInstance()->getWidth();
+        GLint height = this->framebuffer ? this->framebuffer->getHeight() : Config::getInstance()->getHeight();
+        this->updateScene(width, height);
+        if (this->scene) {
+            this->scene->bind();
+        }
+        else if (this->framebuffer) {
+            this->framebuffer->bind();
+        }
+        else {
+            glViewport(0, 0, width, height);
+        }
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
         this->world->render();
         
+        if (this->scene) {
+            this->scene->blit(this->framebuffer.get(), width, height);
+        }
+        
         if (Config::getInstance()->getDebug()) {
             this->debug();
         }
         
+        if (this->framebuffer) {
+            this->framebuffer->unbind();
+        }
+        
+        // Measured before the swap, which waits for the vertical sync
+        GLfloat cpuMs = std::chrono::duration<GLfloat, std::milli>(std::chrono::steady_clock::now() - start).count();
         this->window->refresh();
+        Profiler::getInstance()->endFrame();
+        
+        if (Config::getInstance()->getAdaptiveDistance()) {
+            GLint distance = this->governor->getDistanceView();
+            GLuint superChunks = static_cast<GLuint>((2 * distance + 1) * (2 * distance + 1));
+            // Once the budget limits the loaded area, a larger radius would not load anything more
+            GLint maxDistance = Config::getInstance()->getDistanceView();
+            if (this->world->packet->memoryBound) {
+                maxDistance = std::min(maxDistance, distance);
+                superChunks = std::min(superChunks, this->world->packet->wanted);
+            }
+            this->governor->update(
+                maxDistance, Config::getInstance()->getRenderScale(), cpuMs,
+                Profiler::getInstance()->getGpuFrameTime(), this->world->packet->updateMs,
+                this->world->packet->loaded < superChunks
+            );
+        }
+        
+        // Time between the last mouse sample used by the camera and the presentation of the frame
+        GLfloat latency = std::chrono::duration<GLfloat, std::milli>(
+            std::chrono::steady_clock::now() - this->inputSample
+        ).count();
+        Stats::getInstance()->inputLatency = latency;
+        if (this->benchmark) {
+            this->benchmark->frame(Stats::getInstance()->r_face, latency);
+        }
     }
     
     
-    void Engine::render() const {
+    void Engine::render() {
         static std::chrono::steady_clock::time_point cmptStart = std::chrono::steady_clock::now();
-        static std::chrono::steady_clock::time_point limiterStart = cmptStart;
         static GLuint fps = 0;
+        static GLboolean firstFrame = true;
         
         std::chrono::steady_clock::time_point now;
         GLint64 duration;
         
-        if (Config::getInstance()->getFramerate() > 0) { // Capped framerate
-            now = std::chrono::steady_clock::now();
-            duration =
-                std::chrono::duration_cast<std::chrono::microseconds>(now - limiterStart).count();
-            
-            if (duration >= Config::getInstance()->getFramerateInv()) {
-                this->_render();
-                limiterStart = now;
-                fps++;
-            }
+        if (firstFrame) {
+            this->simulation->waitPacket(1);
+            this->_render();
+            fps++;
+            firstFrame = false;
+            glFinish();
+            std::cout << "[startup] time to first frame: " << std::fixed << std::setprecision(2)
+                      << std::chrono::duration<GLdouble, std::milli>(
+                          std::chrono::steady_clock::now() - this->startTime
+                      ).count() << " ms" << std::endl;
+            return;
         }
-        else { // Uncapped framerate
+        
+        if (this->scheduler->frameDue(Config::getInstance()->getFramerateInv())) {
             this->_render();
             fps++;
         }
@@ -598,13 +925,28 @@ namespace app {
         duration = std::chrono::duration_cast<std::chrono::seconds>(now - cmptStart).count();
         if (duration >= 1) {
             Stats::getInstance()->fps = static_cast<GLuint>(fps);
+            Stats::getInstance()->idle = this->scheduler->sampleIdle();
             fps = 0;
             cmptStart = now;
         }
     }
     
     
+    void Engine::wait() const {
+        this->scheduler->wait(Config::getInstance()->getFramerateInv());
+    }
+    
+    
     void Engine::cleanup() {
+        if (this->framebuffer && !this->capturePath.empty()) {
+            std::unique_ptr<misc::Image>(this->framebuffer->read())->savePNG(this->capturePath);
+            std::cout << "Last frame saved to '" << this->capturePath << "'" << std::endl;
+        }
+        this->simulation.reset();
+        this->scene.reset();
+        this->framebuffer.reset();
+        this->world.reset();
+        Profiler::getInstance()->cleanup();
     }
     
     
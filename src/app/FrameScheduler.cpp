@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <thread>
+
+#include <app/FrameScheduler.hpp>
+
+
+namespace app {
+    
+    constexpr std::chrono::microseconds FrameScheduler::SLEEP_MARGIN;
+    
+    
+    FrameScheduler::FrameScheduler(GLuint tickPerSec) :
+        tickPeriod(std::chrono::microseconds(1000000 / tickPerSec)) {
+        this->reset();
+    }
+    
+    
+    void FrameScheduler::reset() {
+        Clock::time_point now = Clock::now();
+        
+        this->nextTick = now;
+        this->nextFrame = now;
+        this->sampleStart = now;
+        this->idle = Clock::duration::zero();
+    }
+    
+    
+    GLuint FrameScheduler::dueTicks() {
+        Clock::time_point now = Clock::now();
+        
+        if (now < this->nextTick) {
+            return 0;
+        }
+        
+        GLuint64 due = static_cast<GLuint64>((now - this->nextTick) / this->tickPeriod) + 1;
+        if (due > MAX_CATCHUP_TICKS) {
+            this->droppedTicks += due - MAX_CATCHUP_TICKS;
+            this->nextTick = now + this->tickPeriod;
+            return MAX_CATCHUP_TICKS;
+        }
+        
+        this->nextTick += this->tickPeriod * due;
+        return static_cast<GLuint>(due);
+    }
+    
+    
+    GLboolean FrameScheduler::frameDue(GLuint usPerFrame) {
+        Clock::time_point now = Clock::now();
+        
+        if (!usPerFrame) {
+            this->nextFrame = now;
+            return true;
+        }
+        if (now < this->nextFrame) {
+            return false;
+        }
+        
+        // Do not try to catch up missed frames, only keep the pace
+        this->nextFrame = std::max(this->nextFrame + std::chrono::microseconds(usPerFrame), now);
+        return true;
+    }
+    
+    
+    void FrameScheduler::sleepUntil(Clock::time_point deadline) {
+        Clock::time_point start = Clock::now(), now = start;
+        
+        while (now < deadline) {
+            if (deadline - now > SLEEP_MARGIN) {
+                std::this_thread::sleep_for(deadline - now - SLEEP_MARGIN);
+            }
+            else {
+                std::this_thread::yield();
+            }
+            now = Clock::now();
+        }
+        
+        this->idle += now - start;
+    }
+    
+    
+    void FrameScheduler::wait(GLuint usPerFrame) {
+        // Without frame pacing, the render thread draws as often as possible
+        if (!usPerFrame) {
+            return;
+        }
+        
+        this->sleepUntil(this->nextFrame);
+    }
+    
+    
+    void FrameScheduler::waitTick() {
+        this->sleepUntil(this->nextTick);
+    }
+    
+    
+    FrameScheduler::Clock::time_point FrameScheduler::getLastTick() const {
+        return this->nextTick - this->tickPeriod;
+    }
+    
+    
+    GLfloat FrameScheduler::getTickAlpha(Clock::time_point lastTick) const {
+        GLdouble alpha = (
+            std::chrono::duration<GLdouble>(Clock::now() - lastTick)
+            / std::chrono::duration<GLdouble>(this->tickPeriod)
+        );
+        
+        return static_cast<GLfloat>(std::min(1., std::max(0., alpha)));
+    }
+    
+    
+    GLfloat FrameScheduler::sampleIdle() {
+        Clock::time_point now = Clock::now();
+        GLfloat idlePercent = 0;
+        
+        if (now > this->sampleStart) {
+            idlePercent = 100.f * static_cast<GLfloat>(
+                std::chrono::duration<GLdouble>(this->idle) / std::chrono::duration<GLdouble>(now - this->sampleStart)
+            );
+        }
+        
+        this->sampleStart = now;
+        this->idle = Clock::duration::zero();
+        return idlePercent;
+    }
+    
+    
+    GLuint64 FrameScheduler::getDroppedTicks() const {
+        return this->droppedTicks;
+    }
+}
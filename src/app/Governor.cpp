@@ -0,0 +1,140 @@
+#include <algorithm>
+
+#include <app/Governor.hpp>
+#include <app/Config.hpp>
+
+
+namespace app {
+    
+    Governor::Governor(GLint t_distance, GLfloat t_scale) :
+        distance(t_distance), scale(t_scale) {
+    }
+    
+    
+    void Governor::change(GLint t_distance, GLfloat t_scale, GovernorDecision t_decision) {
+        this->distance = t_distance;
+        this->scale = t_scale;
+        this->decision = t_decision;
+        this->overBudget = 0;
+        this->underBudget = 0;
+        this->cooldown = COOLDOWN_FRAMES;
+    }
+    
+    
+    void Governor::update(GLint maxDistance, GLfloat maxScale, GLfloat t_cpuMs, GLfloat t_gpuMs, GLfloat t_updateMs,
+                          GLboolean loading) {
+        GLuint framerate = Config::getInstance()->getFramerate();
+        GLfloat tickMs = 1000.f / static_cast<GLfloat>(Config::TICK_PER_SEC);
+        
+        this->budgetMs = framerate ? 1000.f / static_cast<GLfloat>(framerate) : 0;
+        if (!this->sampled) {
+            this->cpuMs = t_cpuMs;
+            this->gpuMs = t_gpuMs;
+            this->updateMs = t_updateMs;
+            this->sampled = true;
+        }
+        this->cpuMs += (t_cpuMs - this->cpuMs) * SMOOTHING;
+        this->gpuMs += (t_gpuMs - this->gpuMs) * SMOOTHING;
+        this->updateMs += (t_updateMs - this->updateMs) * SMOOTHING;
+        this->frameMs = std::max(this->cpuMs, this->gpuMs);
+        
+        // The settings always win, and nothing limits the radius without a framerate to hold
+        maxDistance = std::max(maxDistance, 0);
+        if (!this->budgetMs) {
+            if (this->distance != maxDistance || this->scale != maxScale) {
+                this->change(maxDistance, maxScale, GOVERNOR_HOLD);
+            }
+            this->decision = GOVERNOR_HOLD;
+            return;
+        }
+        if (this->distance > maxDistance || this->scale > maxScale) {
+            this->change(std::min(this->distance, maxDistance), std::min(this->scale, maxScale), GOVERNOR_HOLD);
+            return;
+        }
+        
+        if (this->cooldown) {
+            this->cooldown--;
+            return;
+        }
+        
+        GLboolean frameHigh = this->frameMs > this->budgetMs * HIGH_LOAD;
+        GLboolean updateHigh = !loading && this->updateMs > tickMs * HIGH_LOAD;
+        GLboolean low = this->frameMs < this->budgetMs * LOW_LOAD && this->updateMs < tickMs * LOW_LOAD;
+        
+        this->overBudget = (frameHigh || updateHigh) ? this->overBudget + 1 : 0;
+        this->underBudget = (low && !loading) ? this->underBudget + 1 : 0;
+        
+        // Only the fill rate depends on the scale, it is lowered first when the GPU is the bottleneck
+        GLboolean scalable = frameHigh && this->gpuMs > this->cpuMs && this->scale > MIN_RENDER_SCALE;
+        
+        if (this->overBudget >= LOWER_FRAMES && scalable) {
+            this->change(
+                this->distance, std::max(this->scale - RENDER_SCALE_STEP, MIN_RENDER_SCALE), GOVERNOR_LOWER_SCALE
+            );
+        }
+        else if (this->overBudget >= LOWER_FRAMES && this->distance > MIN_DISTANCE) {
+            this->change(this->distance - 1, this->scale, frameHigh ? GOVERNOR_LOWER_FRAME : GOVERNOR_LOWER_UPDATE);
+        }
+        else if (this->underBudget >= RAISE_FRAMES && this->distance < maxDistance) {
+            this->change(this->distance + 1, this->scale, GOVERNOR_RAISE);
+        }
+        else if (this->underBudget >= RAISE_FRAMES && this->scale < maxScale) {
+            this->change(this->distance, std::min(this->scale + RENDER_SCALE_STEP, maxScale), GOVERNOR_RAISE_SCALE);
+        }
+        else if (!this->overBudget && !this->underBudget) {
+            this->decision = loading ? GOVERNOR_LOADING : GOVERNOR_HOLD;
+        }
+    }
+    
+    
+    GLint Governor::getDistanceView() const {
+        return this->distance;
+    }
+    
+    
+    GLfloat Governor::getRenderScale() const {
+        return this->scale;
+    }
+    
+    
+    GLfloat Governor::getFrameMs() const {
+        return this->frameMs;
+    }
+    
+    
+    GLfloat Governor::getUpdateMs() const {
+        return this->updateMs;
+    }
+    
+    
+    GLfloat Governor::getBudgetMs() const {
+        return this->budgetMs;
+    }
+    
+    
+    GovernorDecision Governor::getDecision() const {
+        return this->decision;
+    }
+    
+    
+    const char *Governor::getDecisionName(GovernorDecision decision) {
+        switch (decision) {
+            case GOVERNOR_HOLD:
+                return "Hold";
+            case GOVERNOR_LOADING:
+                return "Loading";
+            case GOVERNOR_RAISE:
+                return "Raised";
+            case GOVERNOR_RAISE_SCALE:
+                return "Raised render scale";
+            case GOVERNOR_LOWER_SCALE:
+                return "Lowered render scale (GPU time)";
+            case GOVERNOR_LOWER_FRAME:
+                return "Lowered (frame time)";
+            case GOVERNOR_LOWER_UPDATE:
+                return "Lowered (tick time)";
+        }
+        
+        return "Unknown";
+    }
+}
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <vector>
+
+#include <app/Profiler.hpp>
+
+
+namespace app {
+    
+    Profiler::CpuScope::CpuScope(ProfilerPhase t_phase) :
+        phase(t_phase), start(std::chrono::steady_clock::now()) {
+    }
+    
+    
+    Profiler::CpuScope::~CpuScope() {
+        Profiler::getInstance()->addCpuTime(
+            this->phase,
+            std::chrono::duration<GLdouble, std::milli>(std::chrono::steady_clock::now() - this->start).count()
+        );
+    }
+    
+    
+    Profiler::GpuScope::GpuScope(ProfilerPhase t_phase) :
+        phase(t_phase) {
+        Profiler::getInstance()->beginGpu(this->phase);
+    }
+    
+    
+    Profiler::GpuScope::~GpuScope() {
+        Profiler::getInstance()->endGpu(this->phase);
+    }
+    
+    
+    Profiler *Profiler::getInstance() {
+        static Profiler profiler;
+        return &profiler;
+    }
+    
+    
+    void Profiler::init() {
+        static constexpr ProfilerPhase gpuPhases[] = {
+            PHASE_OPAQUE, PHASE_OCCLUSION_QUERIES, PHASE_ALPHA_TEST, PHASE_SKYBOX, PHASE_SUN, PHASE_BLENDED
+        };
+        static constexpr ProfilerPhase fragmentPhases[] = {
+            PHASE_OPAQUE, PHASE_ALPHA_TEST, PHASE_SKYBOX, PHASE_SUN, PHASE_BLENDED
+        };
+        
+        // Samples passed are core since OpenGL 1.5
+        for (ProfilerPhase phase : fragmentPhases) {
+            this->fragmentQueries[phase] = std::make_unique<tool::QueryRing>(GL_SAMPLES_PASSED);
+        }
+        
+        this->gpuSupported = GLEW_ARB_timer_query;
+        if (!this->gpuSupported) {
+            return;
+        }
+        
+        for (ProfilerPhase phase : gpuPhases) {
+            this->gpuQueries[phase] = std::make_unique<tool::QueryRing>(GL_TIME_ELAPSED);
+        }
+    }
+    
+    
+    void Profiler::cleanup() {
+        for (std::unique_ptr<tool::QueryRing> &ring : this->gpuQueries) {
+            ring.reset();
+        }
+        for (std::unique_ptr<tool::QueryRing> &ring : this->fragmentQueries) {
+            ring.reset();
+        }
+    }
+    
+    
+    void Profiler::addCpuTime(ProfilerPhase phase, GLdouble ms) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->cpuCurrent[phase] += ms;
+    }
+    
+    
+    void Profiler::beginGpu(ProfilerPhase phase) {
+        if (this->gpuQueries[phase]) {
+            this->gpuQueries[phase]->begin();
+        }
+        if (this->fragmentQueries[phase]) {
+            this->fragmentQueries[phase]->begin();
+        }
+    }
+    
+    
+    void Profiler::endGpu(ProfilerPhase phase) {
+        if (this->gpuQueries[phase]) {
+            this->gpuQueries[phase]->end();
+        }
+        if (this->fragmentQueries[phase]) {
+            this->fragmentQueries[phase]->end();
+        }
+    }
+    
+    
+    void Profiler::endFrame() {
+        GLuint64 ns, samples;
+        
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (GLuint phase = 0; phase < PHASE_COUNT; phase++) {
+                this->cpuHistory[phase][this->cpuCursor] = static_cast<GLfloat>(this->cpuCurrent[phase]);
+                this->cpuCurrent[phase] = 0;
+            }
+        }
+        
+        for (GLuint phase = 0; phase < PHASE_COUNT; phase++) {
+            if (this->fragmentQueries[phase]) {
+                while (this->fragmentQueries[phase]->poll(samples)) {
+                    this->fragments[phase] = samples;
+                }
+            }
+            if (!this->gpuQueries[phase]) {
+                continue;
+            }
+            while (this->gpuQueries[phase]->poll(ns)) {
+                this->gpuHistory[phase][this->gpuCursor[phase]] = static_cast<GLfloat>(ns) / 1e6f;
+                this->gpuCursor[phase] = (this->gpuCursor[phase] + 1) % HISTORY;
+            }
+        }
+        
+        this->cpuCursor = (this->cpuCursor + 1) % HISTORY;
+    }
+    
+    
+    const GLfloat *Profiler::getCpuHistory(ProfilerPhase phase) const {
+        return this->cpuHistory[phase].data();
+    }
+    
+    
+    const GLfloat *Profiler::getGpuHistory(ProfilerPhase phase) const {
+        return this->gpuHistory[phase].data();
+    }
+    
+    
+    GLuint Profiler::getCpuOffset() const {
+        return this->cpuCursor;
+    }
+    
+    
+    GLuint Profiler::getGpuOffset(ProfilerPhase phase) const {
+        return this->gpuCursor[phase];
+    }
+    
+    
+    GLfloat Profiler::getGpuFrameTime() const {
+        GLfloat total = 0;
+        
+        for (GLuint phase = 0; phase < PHASE_COUNT; phase++) {
+            if (this->gpuQueries[phase]) {
+                total += this->gpuHistory[phase][(this->gpuCursor[phase] + HISTORY - 1) % HISTORY];
+            }
+        }
+        
+        return total;
+    }
+    
+    
+    GLboolean Profiler::hasGpuTime(ProfilerPhase phase) const {
+        return this->gpuQueries[phase] != nullptr;
+    }
+    
+    
+    GLuint64 Profiler::getFragments(ProfilerPhase phase) const {
+        return this->fragments[phase];
+    }
+    
+    
+    GLboolean Profiler::hasFragments(ProfilerPhase phase) const {
+        return this->fragmentQueries[phase] != nullptr;
+    }
+    
+    
+    const char *Profiler::getPhaseName(ProfilerPhase phase) {
+        switch (phase) {
+            case PHASE_INPUT:
+                return "Input";
+            case PHASE_KEYS:
+                return "Key generation";
+            case PHASE_GENERATION:
+                return "Generation";
+            case PHASE_MESHING:
+                return "Meshing";
+            case PHASE_UPLOAD:
+                return "Upload";
+            case PHASE_VISIBILITY:
+                return "Visibility walk";
+            case PHASE_SOFTWARE_OCCLUSION:
+                return "Software occlusion";
+            case PHASE_OPAQUE:
+                return "Opaque pass";
+            case PHASE_OCCLUSION_QUERIES:
+                return "Occlusion queries";
+            case PHASE_ALPHA_TEST:
+                return "Alpha-tested pass";
+            case PHASE_SKYBOX:
+                return "Skybox";
+            case PHASE_SUN:
+                return "Sun";
+            case PHASE_BLENDED:
+                return "Blended pass";
+        }
+        
+        return "Unknown";
+    }
+    
+    
+    GLfloat Profiler::percentile(const GLfloat *history, GLfloat p) {
+        std::vector<GLfloat> sorted = std::vector<GLfloat>(history, history + HISTORY);
+        auto nth = sorted.begin() + static_cast<GLint64>(p * (HISTORY - 1));
+        
+        std::nth_element(sorted.begin(), nth, sorted.end());
+        return *nth;
+    }
+}
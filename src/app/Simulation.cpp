@@ -0,0 +1,194 @@
+#include <app/Simulation.hpp>
+#include <app/Config.hpp>
+#include <app/Profiler.hpp>
+#include <misc/Trace.hpp>
+
+
+namespace app {
+    
+    Simulation::Simulation(const tool::Camera::Pose &pose, Benchmark *t_benchmark) :
+        benchmark(t_benchmark), scheduler(Config::TICK_PER_SEC) {
+        this->camera.setPoses(pose, pose);
+        this->publish();
+    }
+    
+    
+    Simulation::~Simulation() {
+        this->stop();
+    }
+    
+    
+    void Simulation::start() {
+        this->running = true;
+        this->thread = std::thread(&Simulation::run, this);
+    }
+    
+    
+    void Simulation::stop() {
+        this->running = false;
+        if (this->thread.joinable()) {
+            this->thread.join();
+        }
+    }
+    
+    
+    void Simulation::run() {
+        try {
+            this->scheduler.reset();
+            while (this->running) {
+                GLuint ticks = this->scheduler.dueTicks();
+                if (ticks) {
+                    FrameScheduler::Clock::time_point start = FrameScheduler::Clock::now();
+                    for (GLuint i = 0; i < ticks && this->running; i++) {
+                        this->update(this->takeControls());
+                    }
+                    this->updateMs = std::chrono::duration<GLfloat, std::milli>(
+                        FrameScheduler::Clock::now() - start
+                    ).count() / static_cast<GLfloat>(ticks);
+                    this->publish();
+                }
+                this->scheduler.waitTick();
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->error = std::current_exception();
+        }
+        this->published.notify_all();
+    }
+    
+    
+    Simulation::Controls Simulation::takeControls() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        Controls controls = this->controls;
+        
+        this->inFlightLook += controls.look;
+        this->controls.look = glm::vec2(0);
+        this->controls.switchDayNight = false;
+        
+        return controls;
+    }
+    
+    
+    void Simulation::update(const Controls &controls) {
+        TRACE_SCOPE("Simulation::update");
+        // Day settings are not modified once the engine is initialized
+        Config *config = Config::getInstance();
+        
+        if (this->finished) {
+            return;
+        }
+        
+        this->camera.beginTick();
+        this->previousTickCycle = this->tickCycle;
+        this->tick++;
+        this->tickCycle = static_cast<GLfloat>(
+            static_cast<GLint>((this->tickCycle + 1)) % static_cast<GLint>(config->getTickPerDay())
+        );
+        
+        // Movements
+        this->camera.look(controls.look.x, controls.look.y);
+        this->camera.moveLeft(controls.move.x * controls.speed);
+        this->camera.moveForward(controls.move.z * controls.speed);
+        this->camera.moveUp(controls.move.y * controls.speed);
+        
+        // Toggle day / night
+        if (controls.switchDayNight) {
+            if (this->tickCycle < config->getTickPerDay() / 2) {
+                this->tickCycle = config->getTickDuskEnd();
+            }
+            else {
+                this->tickCycle = config->getTickDawnEnd();
+            }
+        }
+        
+        // Follow the benchmark's path
+        if (this->benchmark) {
+            this->finished = !this->benchmark->update(this->camera);
+        }
+        
+        {
+            Profiler::CpuScope scope = Profiler::CpuScope(PHASE_KEYS);
+            this->chunkManager.updateKeys(this->camera.getPosition(), controls.distanceView, controls.memoryBudget);
+        }
+        {
+            Profiler::CpuScope scope = Profiler::CpuScope(PHASE_GENERATION);
+            this->generated += this->chunkManager.generate();
+        }
+        {
+            Profiler::CpuScope scope = Profiler::CpuScope(PHASE_MESHING);
+            this->chunkManager.mesh(controls.occlusionCulling);
+        }
+        
+        this->underwater = (
+            this->chunkManager.get(this->camera.getPosition()) == cube::CubeData::WATER
+        );
+    }
+    
+    
+    void Simulation::publish() {
+        TRACE_SCOPE("Simulation::publish");
+        std::shared_ptr<RenderPacket> packet = std::make_shared<RenderPacket>();
+        
+        packet->tick = this->tick;
+        packet->time = this->scheduler.getLastTick();
+        packet->previousPose = this->camera.getPreviousPose();
+        packet->pose = this->camera.getPose();
+        packet->previousTickCycle = this->previousTickCycle;
+        packet->tickCycle = this->tickCycle;
+        packet->underwater = this->underwater;
+        packet->finished = this->finished;
+        packet->superChunks = this->chunkManager.getMeshes();
+        packet->loaded = static_cast<GLuint>(this->chunkManager.getSuperChunks().size());
+        packet->generated = this->generated;
+        packet->occludedFace = this->chunkManager.getOccludedCount();
+        packet->memory = this->chunkManager.getMemoryUsage();
+        packet->memoryBound = this->chunkManager.isMemoryBound();
+        packet->wanted = this->chunkManager.getKeyCount();
+        packet->updateMs = this->updateMs;
+        
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->packet = packet;
+            this->inFlightLook = glm::vec2(0);
+        }
+        this->published.notify_all();
+    }
+    
+    
+    void Simulation::control(const Controls &controls) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        glm::vec2 look = this->controls.look + controls.look;
+        GLboolean switchDayNight = this->controls.switchDayNight || controls.switchDayNight;
+        
+        this->controls = controls;
+        this->controls.look = look;
+        this->controls.switchDayNight = switchDayNight;
+    }
+    
+    
+    std::shared_ptr<const RenderPacket> Simulation::getPacket(glm::vec2 &pendingLook) const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+        
+        pendingLook = this->controls.look + this->inFlightLook;
+        return this->packet;
+    }
+    
+    
+    std::shared_ptr<const RenderPacket> Simulation::waitPacket(GLuint64 tick) const {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        
+        this->published.wait(lock, [this, tick]() {
+            return this->packet->tick >= tick || this->error || !this->running;
+        });
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+        
+        return this->packet;
+    }
+}
@@ -1,38 +1,130 @@
+#include <cmath>
+#include <future>
 
 #include <app/World.hpp>
 #include <app/Engine.hpp>
+#include <app/Config.hpp>
+#include <app/Stats.hpp>
+#include <app/Profiler.hpp>
+#include <misc/AssetLoader.hpp>
+#include <misc/Stopwatch.hpp>
+#include <shader/FrameUniforms.hpp>
 
 
 namespace app {
     
     World::World()  {
-        misc::Image *atlas = misc::Image::loadPNG("../assets/block/atlas.png");
+        misc::Stopwatch stopwatch = misc::Stopwatch("world");
         
-        this->chunkManager = std::make_unique<cube::ChunkManager>(atlas);
+        // Decode the atlas while the skybox decodes its own faces
+        std::future<std::unique_ptr<misc::Image>> atlas = misc::AssetLoader::getInstance()->loadImageAsync(
+            "../assets/block/atlas.png"
+        );
         this->skybox = std::make_unique<entity::Skybox>();
+        stopwatch.lap("skybox");
+        this->chunkRenderer = std::make_unique<cube::ChunkRenderer>(atlas.get().get());
+        stopwatch.lap("block textures");
         this->sun = std::make_unique<entity::Sun>();
-        this->chunkManager->init();
+        stopwatch.lap("sun");
+        this->chunkRenderer->init();
+        stopwatch.lap("terrain");
+        this->frameUniforms = std::make_unique<shader::UniformBuffer>(
+            shader::FrameUniforms::BINDING, sizeof(shader::FrameUniforms)
+        );
     }
     
     
     void World::update() {
-        app::Engine *engine = app::Engine::getInstance();
+        app::Stats *stats = app::Stats::getInstance();
+        
+        if (this->packet->tick == this->uploadedTick) {
+            return;
+        }
+        
+        {
+            Profiler::CpuScope scope = Profiler::CpuScope(PHASE_UPLOAD);
+            this->chunkRenderer->update(this->packet->superChunks);
+        }
+        this->uploadedTick = this->packet->tick;
+        
+        stats->g_superchunk = this->packet->generated;
+        stats->occludedFace = this->packet->occludedFace;
+        stats->l_superchunk = this->packet->loaded;
+        stats->l_chunk = stats->l_superchunk * cube::SuperChunk::CHUNK_SIZE;
+        stats->l_cube = stats->l_superchunk * cube::SuperChunk::SIZE;
+        stats->l_face = stats->l_cube * 6;
+        stats->voxelBytes = this->packet->memory.voxels;
+        stats->meshBytes = this->packet->memory.meshes;
+        
+        this->underwater = this->packet->underwater;
+    }
+    
+    
+    void World::interpolate(GLfloat alpha) {
+        GLfloat tickPerDay = app::Config::getInstance()->getTickPerDay();
+        GLfloat delta = this->packet->tickCycle - this->packet->previousTickCycle;
+        
+        if (delta < 0) { // A new day started during the tick
+            delta += tickPerDay;
+        }
         
-        this->chunkManager->update();
+        // Jumps, e.g. when switching between day and night, are not interpolated
+        this->renderTickCycle = delta <= 1.f
+            ? std::fmod(this->packet->previousTickCycle + delta * alpha, tickPerDay)
+            : this->packet->tickCycle;
         this->sun->update();
+    }
     
-        this->underwater = (
-            chunkManager->get(engine->camera->getPosition()) == cube::CubeData::WATER
-        );
+    
+    void World::updateFrameUniforms() const {
+        app::Engine *engine = app::Engine::getInstance();
+        app::Config *config = app::Config::getInstance();
+        shader::FrameUniforms uniforms {};
+        
+        uniforms.view = engine->camera->getViewMatrix();
+        uniforms.projection = engine->camera->getProjMatrix();
+        uniforms.viewProjection = uniforms.projection * uniforms.view;
+        // Remove translation from the view, the skybox follows the camera
+        uniforms.skyboxViewProjection = uniforms.projection * glm::mat4(glm::mat3(uniforms.view));
+        uniforms.normal = glm::transpose(glm::inverse(uniforms.view));
+        
+        glm::vec3 lightColor = config->getLightColor(this->renderTickCycle);
+        if (this->underwater) {
+            lightColor *= glm::vec3(0.36, 0.56, 1);
+        }
+        uniforms.lightPosition = uniforms.view * glm::vec4(this->sun->getPosition(), 0);
+        uniforms.lightColor = glm::vec4(lightColor, 1);
+        uniforms.skyColor = glm::vec4(config->getSkyboxColor(this->renderTickCycle), 1);
+        uniforms.lightDirIntensity = config->getLightDirIntensity(this->renderTickCycle);
+        uniforms.lightAmbIntensity = config->getLightAmbIntensity(this->renderTickCycle);
+        uniforms.verticalOffset = static_cast<GLint>(this->packet->tick % cube::ATLAS_FRAMES);
+        
+        this->frameUniforms->update(&uniforms);
     }
     
     
     void World::render() const {
-        glDisable(GL_DEPTH_TEST);
-        this->skybox->render();
-        glEnable(GL_DEPTH_TEST);
-        this->sun->render();
-        glClear(GL_DEPTH_BUFFER_BIT);
-        this->chunkManager->render();
+        const tool::Camera &camera = *app::Engine::getInstance()->camera;
+        
+        this->updateFrameUniforms();
+        this->chunkRenderer->renderOpaque(camera.getRenderPosition(), camera.getProjMatrix() * camera.getViewMatrix());
+        
+        // The sky is drawn at the far plane, only where the terrain left the depth buffer cleared
+        glDepthFunc(GL_LEQUAL);
+        glDepthMask(GL_FALSE);
+        {
+            Profiler::CpuScope cpuScope = Profiler::CpuScope(PHASE_SKYBOX);
+            Profiler::GpuScope gpuScope = Profiler::GpuScope(PHASE_SKYBOX);
+            this->skybox->render();
+        }
+        {
+            Profiler::CpuScope cpuScope = Profiler::CpuScope(PHASE_SUN);
+            Profiler::GpuScope gpuScope = Profiler::GpuScope(PHASE_SUN);
+            this->sun->render();
+        }
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+        
+        this->chunkRenderer->renderTranslucent(camera.getRenderPosition());
     }
 }
@@ -1,27 +1,21 @@
-#include <iostream>
-#include <exception>
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
 
 #include <cube/Chunk.hpp>
 #include <cube/CubeFace.hpp>
-#include <app/Engine.hpp>
-#include <app/Config.hpp>
+#include <misc/Trace.hpp>
 
 
 namespace cube {
     
-    Chunk::Chunk() {
-        glGenBuffers(1, &this->vboAlpha);
-        glGenVertexArrays(1, &this->vaoAlpha);
-        glGenBuffers(1, &this->vbo);
-        glGenVertexArrays(1, &this->vao);
-    }
-    
-    
-    Chunk::~Chunk() {
-        glDeleteBuffers(1, &this->vboAlpha);
-        glDeleteVertexArrays(1, &this->vaoAlpha);
-        glDeleteBuffers(1, &this->vbo);
-        glDeleteVertexArrays(1, &this->vao);
+    /**
+     * Versions are unique among all the meshes, chunks may be built on a thread and uploaded by
+     * another one after having been unloaded and loaded again.
+     */
+    static GLuint64 nextVersion() {
+        static std::atomic<GLuint64> version(0);
+        return ++version;
     }
     
     
@@ -34,14 +28,8 @@ namespace cube {
     }
     
     
-    bool Chunk::occluded(CubeData type, GLint x, GLint y, GLint z, CubeData direction) const {
-        app::Engine *engine = app::Engine::getInstance();
-        app::Config *config = app::Config::getInstance();
-        
-        if (!config->getOcclusionCulling()) {
-            return false;
-        }
-        
+    bool Chunk::occluded(const IVoxelSource &world, CubeData type, GLint x, GLint y, GLint z,
+                         CubeData direction) const {
         if (onBorder(static_cast<GLubyte>(x), static_cast<GLubyte>(y), static_cast<GLubyte>(z))) {
             x += this->position.x;
             y += this->position.y;
@@ -51,17 +39,17 @@ namespace cube {
             if (type & ALPHA) {
                 switch (direction) {
                     case CubeData::FACE:
-                        return engine->world->chunkManager->get({ x, y, z + 1 }) != CubeData::AIR;
+                        return world.get({ x, y, z + 1 }) != CubeData::AIR;
                     case CubeData::TOP:
-                        return engine->world->chunkManager->get({ x, y + 1, z }) != CubeData::AIR;
+                        return world.get({ x, y + 1, z }) != CubeData::AIR;
                     case CubeData::BACK:
-                        return engine->world->chunkManager->get({ x, y, z - 1 }) != CubeData::AIR;
+                        return world.get({ x, y, z - 1 }) != CubeData::AIR;
                     case CubeData::BOTTOM:
-                        return engine->world->chunkManager->get({ x, y - 1, z }) != CubeData::AIR;
+                        return world.get({ x, y - 1, z }) != CubeData::AIR;
                     case CubeData::LEFT:
-                        return engine->world->chunkManager->get({ x - 1, y, z }) != CubeData::AIR;
+                        return world.get({ x - 1, y, z }) != CubeData::AIR;
                     case CubeData::RIGHT:
-                        return engine->world->chunkManager->get({ x + 1, y, z }) != CubeData::AIR;
+                        return world.get({ x + 1, y, z }) != CubeData::AIR;
                     default:
                         throw std::runtime_error("Received an invalid direction");
                 }
@@ -69,17 +57,17 @@ namespace cube {
             
             switch (direction) {
                 case CubeData::FACE:
-                    return !(engine->world->chunkManager->get({ x, y, z + 1 }) & ALPHA);
+                    return !(world.get({ x, y, z + 1 }) & ALPHA);
                 case CubeData::TOP:
-                    return !(engine->world->chunkManager->get({ x, y + 1, z }) & ALPHA);
+                    return !(world.get({ x, y + 1, z }) & ALPHA);
                 case CubeData::BACK:
-                    return !(engine->world->chunkManager->get({ x, y, z - 1 }) & ALPHA);
+                    return !(world.get({ x, y, z - 1 }) & ALPHA);
                 case CubeData::BOTTOM:
-                    return !(engine->world->chunkManager->get({ x, y - 1, z }) & ALPHA);
+                    return !(world.get({ x, y - 1, z }) & ALPHA);
                 case CubeData::LEFT:
-                    return !(engine->world->chunkManager->get({ x - 1, y, z }) & ALPHA);
+                    return !(world.get({ x - 1, y, z }) & ALPHA);
                 case CubeData::RIGHT:
-                    return !(engine->world->chunkManager->get({ x + 1, y, z }) & ALPHA);
+                    return !(world.get({ x + 1, y, z }) & ALPHA);
                 default:
                     throw std::runtime_error("Received an invalid direction");
             }
@@ -133,7 +121,67 @@ namespace cube {
     }
     
     
-    CubeData Chunk::get(GLubyte x, GLubyte y, GLubyte z) {
+    GLushort Chunk::computeConnectivity() const {
+        static constexpr GLint OFFSETS[SIDE_COUNT][3] = {
+            { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }
+        };
+        
+        bool visited[X][Y][Z] = {};
+        glm::u8vec3 stack[SIZE];
+        GLushort connectivity = 0;
+        GLuint top;
+        GLubyte sides;
+        
+        for (GLubyte x = 0; x < X; x++) {
+            for (GLubyte y = 0; y < Y; y++) {
+                for (GLubyte z = 0; z < Z; z++) {
+                    if (visited[x][y][z] || !(this->cubes[x][y][z] & ALPHA)) {
+                        continue;
+                    }
+                    
+                    // Sides touched by this area of non-opaque cubes
+                    sides = 0;
+                    top = 0;
+                    stack[top++] = { x, y, z };
+                    visited[x][y][z] = true;
+                    while (top) {
+                        glm::u8vec3 cube = stack[--top];
+                        sides |= static_cast<GLubyte>((!cube.x) << SIDE_NEG_X | (cube.x == X - 1) << SIDE_POS_X);
+                        sides |= static_cast<GLubyte>((!cube.y) << SIDE_NEG_Y | (cube.y == Y - 1) << SIDE_POS_Y);
+                        sides |= static_cast<GLubyte>((!cube.z) << SIDE_NEG_Z | (cube.z == Z - 1) << SIDE_POS_Z);
+                        
+                        for (const GLint *offset : OFFSETS) {
+                            GLint nx = cube.x + offset[0], ny = cube.y + offset[1], nz = cube.z + offset[2];
+                            if (nx < 0 || ny < 0 || nz < 0 || nx >= X || ny >= Y || nz >= Z) {
+                                continue;
+                            }
+                            if (visited[nx][ny][nz] || !(this->cubes[nx][ny][nz] & ALPHA)) {
+                                continue;
+                            }
+                            visited[nx][ny][nz] = true;
+                            stack[top++] = glm::u8vec3(nx, ny, nz);
+                        }
+                    }
+                    
+                    for (GLuint a = 0; a < SIDE_COUNT; a++) {
+                        for (GLuint b = a + 1; b < SIDE_COUNT; b++) {
+                            if ((sides >> a & 1u) && (sides >> b & 1u)) {
+                                connectivity |= connectionBit(static_cast<Side>(a), static_cast<Side>(b));
+                            }
+                        }
+                    }
+                    if (connectivity == CONNECTED_ALL) {
+                        return connectivity;
+                    }
+                }
+            }
+        }
+        
+        return connectivity;
+    }
+    
+    
+    CubeData Chunk::get(GLubyte x, GLubyte y, GLubyte z) const {
         assert(x < X);
         assert(y < Y);
         assert(z < Z);
@@ -157,22 +205,46 @@ namespace cube {
     }
     
     
+    glm::ivec3 Chunk::getPosition() const {
+        return this->position;
+    }
+    
+    
     void Chunk::touch() {
         this->modified = true;
     }
     
     
-    GLuint Chunk::update() {
-        static constexpr GLint FACE_COUNT = SIZE * 6;
-        
+    GLuint Chunk::update(const IVoxelSource &world, GLboolean occlusionCulling) {
         if (!modified) {
-            return this->count;
+            return this->mesh->getFaceCount();
+        }
+        
+        TRACE_SCOPE_POS("Chunk::update", this->position);
+        
+        // Published meshes are never modified, they may still be read by the render thread
+        std::shared_ptr<ChunkMesh> mesh = std::make_shared<ChunkMesh>();
+        std::vector<CubeFace> &drawn = mesh->faces[MATERIAL_OPAQUE];
+        for (GLuint material = 0; material < MATERIAL_COUNT; material++) {
+            mesh->faces[material].reserve(this->mesh->faces[material].size());
+        }
+        
+        // Opaque faces are grouped by side, so that the sides facing away from the camera can be
+        // skipped when drawing
+        std::vector<CubeFace> sides[SIDE_COUNT];
+        for (GLuint side = 0; side < SIDE_COUNT; side++) {
+            sides[side].reserve(this->mesh->sides[side + 1] - this->mesh->sides[side]);
         }
         
-        this->countAlpha = 0;
-        this->count = 0;
+        auto occluded = [&](CubeData type, GLint x, GLint y, GLint z, CubeData direction) {
+            return occlusionCulling && this->occluded(world, type, x, y, z, direction);
+        };
+        GLuint faces = 0; // Faces emitted by the current cube
+        auto emit = [&faces](std::vector<CubeFace> &target, const CubeFace &face) {
+            target.push_back(face);
+            faces++;
+        };
         
-        CubeFace drawnAlpha[FACE_COUNT], drawn[FACE_COUNT];
         bool opaqueAbove = false;
         CubeData data;
         GLubyte y;
@@ -187,166 +259,96 @@ namespace cube {
                         continue;
                     }
                     
+                    faces = 0;
                     if (data & ALPHA) {
+                        std::vector<CubeFace> &drawnAlpha = mesh->faces[getMaterial(data)];
                         opaqueAbove = false;
                         if (!occluded(data, x, y, z, CubeData::TOP)) {
-                            drawnAlpha[this->countAlpha++] = CubeFace::top(
+                            emit(drawnAlpha, CubeFace::top(
                                 x, y, z, data | CubeData::TOP
-                            );
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::BOTTOM)) {
-                            drawnAlpha[this->countAlpha++] = CubeFace::bottom(
+                            emit(drawnAlpha, CubeFace::bottom(
                                 x, y, z, data | CubeData::BOTTOM
-                            );
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::FACE)) {
-                            drawnAlpha[this->countAlpha++] = CubeFace::face(
+                            emit(drawnAlpha, CubeFace::face(
                                 x, y, z, data | CubeData::FACE
-                            );
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::BACK)) {
-                            drawnAlpha[this->countAlpha++] = CubeFace::back(
+                            emit(drawnAlpha, CubeFace::back(
                                 x, y, z, data | CubeData::BACK
-                            );
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::LEFT)) {
-                            drawnAlpha[this->countAlpha++] = CubeFace::left
+                            emit(drawnAlpha, CubeFace::left
                                 (x, y, z, data | CubeData::LEFT
-                                );
+                                ));
                         }
                         if (!occluded(data, x, y, z, CubeData::RIGHT)) {
-                            drawnAlpha[this->countAlpha++] = CubeFace::right(
+                            emit(drawnAlpha, CubeFace::right(
                                 x, y, z, data | CubeData::RIGHT
-                            );
+                            ));
                         }
                     }
                     else {
                         if (!occluded(data, x, y, z, CubeData::TOP)) {
-                            drawn[this->count++] = CubeFace::top(
+                            emit(sides[SIDE_POS_Y], CubeFace::top(
                                 x, y, z, data | CubeData::TOP
-                            );
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::BOTTOM)) {
-                            drawn[this->count++] = CubeFace::bottom(
+                            emit(sides[SIDE_NEG_Y], CubeFace::bottom(
                                 x, y, z, data | CubeData::BOTTOM
-                            );
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::FACE)) {
-                            drawn[this->count++] = CubeFace::face(
-                                x, y, z, computeData(data, CubeData::FACE, opaqueAbove
-                                )
-                            );
+                            emit(sides[SIDE_POS_Z], CubeFace::face(
+                                x, y, z, computeData(data, CubeData::FACE, opaqueAbove)
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::BACK)) {
-                            drawn[this->count++] = CubeFace::back(
-                                x, y, z, computeData(data, CubeData::BACK, opaqueAbove
-                                )
-                            );
+                            emit(sides[SIDE_NEG_Z], CubeFace::back(
+                                x, y, z, computeData(data, CubeData::BACK, opaqueAbove)
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::LEFT)) {
-                            drawn[this->count++] = CubeFace::left(
-                                x, y, z, computeData(data, CubeData::LEFT, opaqueAbove
-                                )
-                            );
+                            emit(sides[SIDE_NEG_X], CubeFace::left(
+                                x, y, z, computeData(data, CubeData::LEFT, opaqueAbove)
+                            ));
                         }
                         if (!occluded(data, x, y, z, CubeData::RIGHT)) {
-                            drawn[this->count++] = CubeFace::right(
+                            emit(sides[SIDE_POS_X], CubeFace::right(
                                 x, y, z, computeData(data, CubeData::RIGHT, opaqueAbove)
-                            );
+                            ));
                         }
                         opaqueAbove = true;
                     }
+                    
+                    mesh->cubeCount += faces > 0;
+                    mesh->occludedCount += 6 - faces;
                 }
             }
         }
         
-        // Fill the VBOs
-        glBindBuffer(GL_ARRAY_BUFFER, this->vboAlpha);
-        glBufferData(
-            GL_ARRAY_BUFFER, sizeof(CubeFace) * this->countAlpha, drawnAlpha, GL_STATIC_DRAW
-        );
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(CubeFace) * this->count, drawn, GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        
-        // Set the VAOs
-        glBindVertexArray(this->vaoAlpha);
-        glBindBuffer(GL_ARRAY_BUFFER, this->vboAlpha);
-        glEnableVertexAttribArray(VERTEX_ATTR_POSITION);
-        glEnableVertexAttribArray(VERTEX_ATTR_NORMAL);
-        glEnableVertexAttribArray(VERTEX_ATTR_TEXTURE);
-        glEnableVertexAttribArray(VERTEX_ATTR_DATA);
-        glVertexAttribPointer(
-            VERTEX_ATTR_POSITION, 3, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, vertex))
-        );
-        glVertexAttribPointer(
-            VERTEX_ATTR_NORMAL, 3, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, normal))
-        );
-        glVertexAttribPointer(
-            VERTEX_ATTR_TEXTURE, 2, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, texture))
-        );
-        glVertexAttribIPointer(
-            VERTEX_ATTR_DATA, 1, GL_SHORT, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, data))
-        );
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        
-        glBindVertexArray(this->vao);
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glEnableVertexAttribArray(VERTEX_ATTR_POSITION);
-        glEnableVertexAttribArray(VERTEX_ATTR_NORMAL);
-        glEnableVertexAttribArray(VERTEX_ATTR_TEXTURE);
-        glEnableVertexAttribArray(VERTEX_ATTR_DATA);
-        glVertexAttribPointer(
-            VERTEX_ATTR_POSITION, 3, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, vertex))
-        );
-        glVertexAttribPointer(
-            VERTEX_ATTR_NORMAL, 3, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, normal))
-        );
-        glVertexAttribPointer(
-            VERTEX_ATTR_TEXTURE, 2, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, texture))
-        );
-        glVertexAttribIPointer(
-            VERTEX_ATTR_DATA, 1, GL_UNSIGNED_SHORT, sizeof(cube::CubeVertex),
-            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, data))
-        );
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        for (GLuint side = 0; side < SIDE_COUNT; side++) {
+            mesh->sides[side] = static_cast<GLuint>(drawn.size());
+            drawn.insert(drawn.end(), sides[side].begin(), sides[side].end());
+        }
+        mesh->sides[SIDE_COUNT] = static_cast<GLuint>(drawn.size());
         
+        mesh->connectivity = this->computeConnectivity();
+        mesh->version = nextVersion();
+        this->mesh = mesh;
         this->modified = false;
-        return this->count + this->countAlpha;
+        return mesh->getFaceCount();
     }
     
     
-    GLuint Chunk::render(bool alpha) const {
-        assert(!modified);
-    
-        
-        if (this->count + this->countAlpha == 0) {
-            return 0;
-        }
-        
-        if (!alpha) {
-            glBindVertexArray(this->vao);
-            glDrawArrays(GL_TRIANGLES, 0,
-                         static_cast<GLsizei>(this->count * CubeFace::VERTICE_COUNT));
-            glBindVertexArray(0);
-            return this->count;
-        }
-        else {
-            glBindVertexArray(this->vaoAlpha);
-            glDrawArrays(GL_TRIANGLES, 0,
-                         static_cast<GLsizei>(this->countAlpha * CubeFace::VERTICE_COUNT));
-            glBindVertexArray(0);
-            return this->countAlpha;
-        }
+    const std::shared_ptr<const ChunkMesh> &Chunk::getMesh() const {
+        return this->mesh;
     }
 }
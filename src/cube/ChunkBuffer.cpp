@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include <cube/ChunkBuffer.hpp>
+#include <cube/Chunk.hpp>
+#include <app/Stats.hpp>
+#include <misc/Trace.hpp>
+
+
+namespace cube {
+    
+    ChunkBuffer::~ChunkBuffer() {
+        app::Stats *stats = app::Stats::getInstance();
+        
+        for (GLuint material = 0; material < MATERIAL_COUNT; material++) {
+            if (this->vbo[material]) {
+                glDeleteBuffers(1, &this->vbo[material]);
+                glDeleteVertexArrays(1, &this->vao[material]);
+                stats->glObject -= 2;
+                stats->bufferBytes -= sizeof(CubeFace) * this->count[material];
+            }
+        }
+        if (this->query) {
+            glDeleteQueries(1, &this->query);
+            stats->glObject--;
+        }
+    }
+    
+    
+    void ChunkBuffer::allocate(Material material, VertexArrayPool &pool) {
+        if (pool.acquire(this->vbo[material], this->vao[material])) {
+            return;
+        }
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        app::Stats *stats = app::Stats::getInstance();
+        
+        glGenBuffers(1, &this->vbo[material]);
+        glGenVertexArrays(1, &this->vao[material]);
+        setAttributes(this->vao[material], this->vbo[material]);
+        
+        stats->glObject += 2;
+        stats->g_glObject += 2;
+        stats->glObjectMs += std::chrono::duration<GLdouble, std::milli>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+    }
+    
+    
+    void ChunkBuffer::release(Material material, VertexArrayPool &pool) {
+        pool.release(this->vbo[material], this->vao[material]);
+        this->vbo[material] = 0;
+        this->vao[material] = 0;
+    }
+    
+    
+    void ChunkBuffer::setAttributes(GLuint vao, GLuint vbo) {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glEnableVertexAttribArray(VERTEX_ATTR_POSITION);
+        glEnableVertexAttribArray(VERTEX_ATTR_NORMAL);
+        glEnableVertexAttribArray(VERTEX_ATTR_TEXTURE);
+        glEnableVertexAttribArray(VERTEX_ATTR_DATA);
+        glVertexAttribPointer(
+            VERTEX_ATTR_POSITION, 3, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
+            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, vertex))
+        );
+        glVertexAttribPointer(
+            VERTEX_ATTR_NORMAL, 3, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
+            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, normal))
+        );
+        glVertexAttribPointer(
+            VERTEX_ATTR_TEXTURE, 2, GL_BYTE, GL_FALSE, sizeof(cube::CubeVertex),
+            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, texture))
+        );
+        glVertexAttribIPointer(
+            VERTEX_ATTR_DATA, 1, GL_UNSIGNED_SHORT, sizeof(cube::CubeVertex),
+            reinterpret_cast<const GLvoid *>(offsetof(cube::CubeVertex, data))
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+    
+    
+    void ChunkBuffer::reset() {
+        // Counted as freed, the faces still held by the buffers are replaced by the next upload
+        for (GLuint material = 0; material < MATERIAL_COUNT; material++) {
+            app::Stats::getInstance()->bufferBytes -= sizeof(CubeFace) * this->count[material];
+        }
+        std::fill(std::begin(this->count), std::end(this->count), 0);
+        std::fill(std::begin(this->sides), std::end(this->sides), 0);
+        this->cubeCount = 0;
+        this->version = 0;
+        this->visible = true;
+        this->pending = false;
+        this->culled = false;
+        this->reachable = true;
+        this->connectivity = CONNECTED_ALL;
+    }
+    
+    
+    bool ChunkBuffer::upload(const ChunkMesh &mesh, VertexArrayPool &pool) {
+        if (mesh.version == this->version) {
+            return false;
+        }
+        
+        TRACE_SCOPE("Chunk::upload");
+        app::Stats *stats = app::Stats::getInstance();
+        
+        this->cubeCount = mesh.cubeCount;
+        std::copy(std::begin(mesh.sides), std::end(mesh.sides), std::begin(this->sides));
+        this->connectivity = mesh.connectivity;
+        this->version = mesh.version;
+        
+        for (GLuint material = 0; material < MATERIAL_COUNT; material++) {
+            stats->bufferBytes -= sizeof(CubeFace) * this->count[material];
+            this->count[material] = static_cast<GLuint>(mesh.faces[material].size());
+            stats->bufferBytes += sizeof(CubeFace) * this->count[material];
+            if (!this->count[material]) {
+                if (this->vbo[material]) {
+                    this->release(static_cast<Material>(material), pool);
+                }
+                continue;
+            }
+            if (!this->vbo[material]) {
+                this->allocate(static_cast<Material>(material), pool);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, this->vbo[material]);
+            glBufferData(
+                GL_ARRAY_BUFFER, sizeof(CubeFace) * this->count[material], mesh.faces[material].data(),
+                GL_STATIC_DRAW
+            );
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        
+        return true;
+    }
+    
+    
+    GLuint ChunkBuffer::render(Material material, GLubyte sides) const {
+        if (!this->count[material] || this->isSkipped()) {
+            return 0;
+        }
+        
+        // Ranges of faces to draw, consecutive sides being merged into a single range
+        GLint first[SIDE_COUNT];
+        GLsizei count[SIDE_COUNT];
+        GLsizei ranges = 0;
+        GLuint drawn = 0;
+        if (material != MATERIAL_OPAQUE || sides == SIDES_ALL) {
+            first[0] = 0;
+            count[0] = static_cast<GLsizei>(this->count[material] * CubeFace::VERTICE_COUNT);
+            drawn = this->count[material];
+            ranges = 1;
+        }
+        else {
+            GLuint end = 0; // Face following the last range
+            for (GLuint side = 0; side < SIDE_COUNT; side++) {
+                GLuint faces = this->sides[side + 1] - this->sides[side];
+                if (!(sides & (1u << side)) || !faces) {
+                    continue;
+                }
+                if (!ranges || end != this->sides[side]) {
+                    first[ranges] = static_cast<GLint>(this->sides[side] * CubeFace::VERTICE_COUNT);
+                    count[ranges] = 0;
+                    ranges++;
+                }
+                count[ranges - 1] += static_cast<GLsizei>(faces * CubeFace::VERTICE_COUNT);
+                end = this->sides[side + 1];
+                drawn += faces;
+            }
+            if (!ranges) {
+                return 0;
+            }
+        }
+        
+        // Do not wait for the result, the chunk is drawn if the query is not over yet
+        if (!this->visible) {
+            glBeginConditionalRender(this->query, GL_QUERY_NO_WAIT);
+        }
+        glBindVertexArray(this->vao[material]);
+        if (ranges == 1) {
+            glDrawArrays(GL_TRIANGLES, first[0], count[0]);
+        }
+        else {
+            glMultiDrawArrays(GL_TRIANGLES, first, count, ranges);
+        }
+        glBindVertexArray(0);
+        if (!this->visible) {
+            glEndConditionalRender();
+        }
+        
+        return this->visible ? drawn : 0;
+    }
+    
+    
+    GLubyte ChunkBuffer::getFacingSides(const glm::vec3 &position, const glm::vec3 &camera) {
+        // A face looking toward +X is only seen from the +X side of its plane, every such face of
+        // the chunk lying between its lowest and its highest X
+        glm::vec3 max = position + glm::vec3(Chunk::X, Chunk::Y, Chunk::Z);
+        GLubyte sides = 0;
+        
+        sides |= static_cast<GLubyte>((camera.x < max.x) << SIDE_NEG_X | (camera.x > position.x) << SIDE_POS_X);
+        sides |= static_cast<GLubyte>((camera.y < max.y) << SIDE_NEG_Y | (camera.y > position.y) << SIDE_POS_Y);
+        sides |= static_cast<GLubyte>((camera.z < max.z) << SIDE_NEG_Z | (camera.z > position.z) << SIDE_POS_Z);
+        
+        return sides;
+    }
+    
+    
+    void ChunkBuffer::readQuery() {
+        GLuint available = GL_FALSE;
+        GLuint passed = GL_TRUE;
+        
+        if (!this->pending) {
+            return;
+        }
+        
+        glGetQueryObjectuiv(this->query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            glGetQueryObjectuiv(this->query, GL_QUERY_RESULT, &passed);
+            this->visible = passed != GL_FALSE;
+            this->pending = false;
+        }
+    }
+    
+    
+    bool ChunkBuffer::needsQuery(GLuint64 frame) const {
+        return !this->visible || (!this->pending && frame % QUERY_INTERVAL == 0);
+    }
+    
+    
+    void ChunkBuffer::beginQuery() {
+        if (!this->query) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            app::Stats *stats = app::Stats::getInstance();
+            
+            glGenQueries(1, &this->query);
+            stats->glObject++;
+            stats->g_glObject++;
+            stats->glObjectMs += std::chrono::duration<GLdouble, std::milli>(
+                std::chrono::steady_clock::now() - start
+            ).count();
+        }
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, this->query);
+    }
+    
+    
+    void ChunkBuffer::endQuery() {
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+        this->pending = true;
+    }
+    
+    
+    void ChunkBuffer::setVisible() {
+        this->visible = true;
+        this->pending = false;
+    }
+    
+    
+    GLboolean ChunkBuffer::isVisible() const {
+        return this->visible;
+    }
+    
+    
+    void ChunkBuffer::setCulled(GLboolean culled) {
+        this->culled = culled;
+    }
+    
+    
+    GLboolean ChunkBuffer::isCulled() const {
+        return this->culled;
+    }
+    
+    
+    void ChunkBuffer::setReachable(GLboolean reachable) {
+        this->reachable = reachable;
+    }
+    
+    
+    GLboolean ChunkBuffer::isReachable() const {
+        return this->reachable;
+    }
+    
+    
+    bool ChunkBuffer::isSkipped() const {
+        return this->culled || !this->reachable;
+    }
+    
+    
+    bool ChunkBuffer::connects(Side a, Side b) const {
+        return a == b || (this->connectivity & connectionBit(a, b));
+    }
+    
+    
+    bool ChunkBuffer::isEmpty() const {
+        for (GLuint material = 0; material < MATERIAL_COUNT; material++) {
+            if (this->count[material]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    
+    GLuint ChunkBuffer::getFaceCount(Material material) const {
+        return this->count[material];
+    }
+    
+    
+    GLuint ChunkBuffer::getCubeCount() const {
+        return this->cubeCount;
+    }
+}
@@ -1,139 +1,98 @@
 #include <algorithm>
-#include <iostream>
+#include <cmath>
+#include <iterator>
 
-#include <effolkronium/random.hpp>
-#include <glm/ext.hpp>
-
-#include <app/Engine.hpp>
 #include <cube/ChunkManager.hpp>
-#include <cube/ColumnGenerator.hpp>
-#include <cube/TreeGenerator.hpp>
-#include <app/Stats.hpp>
-
 
-using Random = effolkronium::random_static;
 
 namespace cube {
     
-    ChunkManager::ChunkManager(const misc::Image *t_cubeTexture) :
-        textureVerticalOffset(0),
-        temperatureNoise(
-            { Random::get<float>(0., 100000.), Random::get<float>(0., 100000.) }, 5, 1.f, 1 / 258.f,
-            0.5f, 2.f
-        ),
-        
-        carvingNoise(
-            {
-                Random::get<float>(0., 100000.), Random::get<float>(0., 100000.),
-                Random::get<float>(0., 100000.)
-            },
-            3, 1.f, 1 / 64.f, 0.5f, 2.f
-        ),
-        
-        cubeTexture(shader::Texture(t_cubeTexture)),
-        heightNoise({ Random::get<float>(0., 100000.), Random::get<float>(0., 100000.) }, 3, 1.f,
-                    1 / 256.f, 0.5f, 2.f
-        ) {
-        
-        cubeTexture.bind();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        cubeTexture.unbind();
+    /**
+     * Return the squared horizontal distance between two positions.
+     */
+    static GLint squaredDistance(const glm::ivec3 &a, const glm::ivec3 &b) {
+        GLint x = a.x - b.x;
+        GLint z = a.z - b.z;
+        return x * x + z * z;
     }
     
     
-    void ChunkManager::generateKeys() {
-        app::Engine *engine = app::Engine::getInstance();
-        app::Config *config = app::Config::getInstance();
-        
-        glm::vec3 camera = engine->camera->getPosition();
-        glm::ivec3 position = getSuperChunkCoordinates(camera);
-        GLint distanceView = config->getDistanceView();
+    void ChunkManager::updateKeys(const glm::ivec3 &center, GLint distanceView, GLuint64 budget) {
+        glm::ivec3 position = getSuperChunkCoordinates(center);
         
         GLint startx = position.x - distanceView * SuperChunk::X;
         GLint startz = position.z - distanceView * SuperChunk::Z;
         GLint endx = position.x + distanceView * SuperChunk::X;
         GLint endz = position.z + distanceView * SuperChunk::Z;
         
-        std::vector<glm::ivec3> keys = std::vector<glm::ivec3>();
+        this->keys.clear();
         for (GLint x = startx; x <= endx; x += SuperChunk::X) {
             for (GLint z = startz; z <= endz; z += SuperChunk::Z) {
-                keys.emplace_back(x, 0, z);
+                this->keys.emplace_back(x, 0, z);
             }
         }
         
-        this->keys = keys;
-    }
-    
-    
-    CubeData ChunkManager::getBiome(GLuint height, GLfloat temperature) {
-        assert(height >= app::Config::GEN_MIN_H);
-        assert(height <= app::Config::GEN_MAX_H);
-        
-        static constexpr GLubyte sandLevel = app::Config::GEN_WATER_LEVEL + 3;
-        static constexpr GLubyte dirtLevel = sandLevel + 18;
-        static constexpr GLubyte stoneLevel = dirtLevel + 4;
-        
-        if (temperature < -0.30f) { // Snow biome
-            if (height <= app::Config::GEN_WATER_LEVEL) {
-                return CubeData::ICE;
+        // Keep the nearest superchunks fitting in the budget, the pool is trimmed to fit beside them
+        GLuint64 cost = budget ? this->getSuperChunkBytes() : 0;
+        this->memoryBound = false;
+        if (budget) {
+            auto nearer = [&position](GLint distance) {
+                return [&position, distance](const glm::ivec3 &key) {
+                    return squaredDistance(key, position) < distance;
+                };
+            };
+            size_t fitting = std::max<size_t>(budget / cost, 1);
+            
+            std::sort(this->keys.begin(), this->keys.end(), [&position](const glm::ivec3 &a, const glm::ivec3 &b) {
+                return squaredDistance(a, position) < squaredDistance(b, position);
+            });
+            auto kept = std::partition_point(this->keys.begin(), this->keys.end(), nearer(this->budgetDistance));
+            if (static_cast<size_t>(kept - this->keys.begin()) > fitting) {
+                this->budgetDistance = squaredDistance(this->keys[fitting], position);
             }
-            if (height <= sandLevel) {
-                return CubeData::SNOW;
-            }
-            if (height <= dirtLevel) {
-                return CubeData::DIRT_SNOW;
-            }
-            if (height <= stoneLevel) {
-                return CubeData::STONE_SNOW;
+            else if (kept != this->keys.end()) {
+                // Grow by the next ring only if it fits with some margin, or it would be unloaded again
+                GLint next = squaredDistance(*kept, position) + 1;
+                auto grown = std::partition_point(kept, this->keys.end(), nearer(next));
+                GLfloat count = static_cast<GLfloat>(grown - this->keys.begin());
+                if (count <= static_cast<GLfloat>(fitting) * GROW_LOAD) {
+                    this->budgetDistance = next;
+                }
             }
-            return CubeData::SNOW;
+            
+            kept = std::partition_point(this->keys.begin(), this->keys.end(), nearer(this->budgetDistance));
+            this->memoryBound = kept != this->keys.end();
+            this->keys.erase(kept, this->keys.end());
         }
-        else if (temperature < -0.125f || (temperature > 0.125f && temperature < 0.30f)) {
-            // Plain biome
-            if (height <= app::Config::GEN_WATER_LEVEL) {
-                return CubeData::WATER;
-            }
-            if (height <= sandLevel) {
-                return CubeData::SAND_BEACH;
-            }
-            if (height <= dirtLevel) {
-                return CubeData::DIRT_PLAIN;
-            }
-            if (height <= stoneLevel) {
-                return CubeData::STONE;
-            }
-            return CubeData::STONE_SNOW;
+        else {
+            this->budgetDistance = std::numeric_limits<GLint>::max();
         }
-        else if (temperature < 0.125f) { // Jungle biome
-            if (height <= app::Config::GEN_WATER_LEVEL) {
-                return CubeData::WATER;
-            }
-            if (height <= sandLevel) {
-                return CubeData::DIRT_JUNGLE;
-            }
-            if (height <= dirtLevel) {
-                return CubeData::DIRT_JUNGLE;
-            }
-            if (height <= stoneLevel) {
-                return CubeData::STONE;
+        
+        // Move superChunk outside distanceView to the pool, the node keeps the superchunk
+        for (auto it = this->chunks.begin(); it != this->chunks.end();) {
+            const glm::ivec3 &key = it->first;
+            if (key.x >= startx && key.x <= endx && key.z >= startz && key.z <= endz
+                && squaredDistance(key, position) < this->budgetDistance) {
+                it++;
+                continue;
             }
-            return CubeData::STONE;
-        }
-        // Desert biome
-        if (height <= app::Config::GEN_WATER_LEVEL) {
-            return CubeData::WATER;
-        }
-        if (height <= sandLevel) {
-            return CubeData::SAND_BEACH;
+            auto next = std::next(it);
+            this->pool.push_back(this->chunks.extract(it));
+            it = next;
         }
-        if (height <= dirtLevel) {
-            return CubeData::SAND_DESERT;
+        
+        // Enough to load a row and a column of superchunks, free the rest once the distance shrinks
+        size_t maxPooled = static_cast<size_t>(2 * (2 * std::max(distanceView, 0) + 1));
+        if (budget) {
+            // Every loaded superchunk is a key, the missing ones are generated from the pool first
+            GLuint64 reserved = this->keys.size() * cost;
+            size_t missing = this->keys.size() - this->chunks.size();
+            size_t spare = budget > reserved ? (budget - reserved) / cost : 0;
+            maxPooled = std::min(maxPooled, missing + spare);
         }
-        if (height <= stoneLevel) {
-            return CubeData::SAND_DESERT;
+        if (this->pool.size() > maxPooled) {
+            this->pool.erase(this->pool.begin() + static_cast<std::ptrdiff_t>(maxPooled), this->pool.end());
         }
-        return CubeData::STONE;
     }
     
     
@@ -155,109 +114,57 @@ namespace cube {
     }
     
     
-    SuperChunk *ChunkManager::createSuperChunk(glm::ivec3 position) {
-        auto *chunk = new SuperChunk(position);
-        std::array<CubeData, SuperChunk::Y> column {};
-        CubeData biome;
-        float temperature;
-        GLubyte height;
-        GLuint x, y, z, y2;
+    GLuint ChunkManager::generate() {
+        GLuint generated = 0;
         
-        // Set eight of each column
-        for (x = 0; x < SuperChunk::X; x++) {
-            for (z = 0; z < SuperChunk::Z; z++) {
-                height = static_cast<GLubyte>(this->heightNoise(
-                    { position.x + GLint(x), position.z + GLint(z) }, -1, 1,
-                    app::Config::GEN_MIN_H,
-                    app::Config::GEN_MAX_H
-                ));
-                for (y = 0; y <= height; y++) {
-                    chunk->set(x, y, z, CubeData::STONE);
-                }
-                for (y = height + 1; y < SuperChunk::Y; y++) {
-                    chunk->set(x, y, z, CubeData::AIR);
-                }
+        // Add new superChunk that entered distanceView
+        for (const glm::ivec3 &position : this->keys) {
+            if (this->chunks.count(position)) {
+                continue;
             }
-        }
-        
-        // Create more unusual terrain by subtracting 3D noise
-        glm::vec3 point;
-        for (x = 0; x < SuperChunk::X; x++) {
-            for (y = app::Config::GEN_CARVING_H; y < app::Config::GEN_MAX_H;
-                 y++) {
-                for (z = 0; z < SuperChunk::Z; z++) {
-                    point = { position.x + GLint(x), position.y + GLint(y), position.z + GLint(z) };
-                    if (this->carvingNoise(point) > 0.f) {
-                        chunk->set(x, y, z, CubeData::AIR);
-                    }
-                }
+            
+            SuperChunk *chunk;
+            if (this->pool.empty()) {
+                chunk = this->chunks.emplace(position, std::make_unique<SuperChunk>(position)).first->second.get();
             }
-        }
-        
-        // Generate biome over terrain
-        for (x = 0; x < SuperChunk::X; x++) {
-            for (z = 0; z < SuperChunk::Z; z++) {
-                for (y = app::Config::GEN_MAX_H; y >= app::Config::GEN_MIN_H; y--) {
-                    if (chunk->get(x, y, z) != CubeData::AIR) {
-                        temperature = this->temperatureNoise(
-                            { position.x + GLint(x), position.z + GLint(z) }
-                        );
-                        biome = ChunkManager::getBiome(y, temperature);
-                        column = ColumnGenerator::generate(y, biome);
-                        for (y2 = app::Config::GEN_MIN_H; y2 <= app::Config::GEN_MAX_H; y2++) {
-                            chunk->set(x, y2, z, column[y2]);
-                        }
-                        break;
-                    }
-                }
+            else {
+                SuperChunkMap::node_type node = std::move(this->pool.back());
+                this->pool.pop_back();
+                node.key() = position;
+                node.mapped()->reset(position);
+                chunk = this->chunks.insert(std::move(node)).position->second.get();
             }
-        }
-        
-        // Generate Tree or slimes on certain position
-        for (x = 0; x < SuperChunk::X; x++) {
-            for (z = 0; z < SuperChunk::Z; z++) {
-                for (y = app::Config::GEN_MAX_H; y >= app::Config::GEN_MIN_H; y--) {
-                    if (!(chunk->get(x, y, z) & NOT_FLOOR)) {
-                        biome = chunk->get(x, y, z);
-                        
-                        // Try to generate a tree at position
-                        Tree tree = TreeGenerator::generate({ x, y, z }, biome);
-                        if (!tree.empty()) { // If a tree was generated
-                            std::for_each(
-                                tree.begin(), tree.end(),
-                                [&chunk](const auto &e) {
-                                    chunk->set(
-                                        static_cast<GLuint>(e.first.x),
-                                        static_cast<GLuint>(e.first.y),
-                                        static_cast<GLuint>(e.first.z),
-                                        e.second
-                                    );
-                                }
-                            );
-                        }
-                        break;
+            this->generator.generate(*chunk);
+            generated++;
+            
+            // Neighbours must be meshed again to remove faces hidden by the new superchunk
+            GLint startx = position.x - SuperChunk::X;
+            GLint startz = position.z - SuperChunk::Z;
+            GLint endx = position.x + SuperChunk::X;
+            GLint endz = position.z + SuperChunk::Z;
+            for (GLint x = startx; x <= endx; x += SuperChunk::X) {
+                for (GLint z = startz; z <= endz; z += SuperChunk::Z) {
+                    if (this->chunks.count({ x, 0, z })) {
+                        this->chunks.at({ x, 0, z })->touch();
                     }
                 }
             }
         }
         
-        GLint startx = position.x - SuperChunk::X;
-        GLint startz = position.z - SuperChunk::Z;
-        GLint endx = position.x + SuperChunk::X;
-        GLint endz = position.z + SuperChunk::Z;
-        for (GLint x = startx; x <= endx; x += SuperChunk::X) {
-            for (GLint z = startz; z <= endz; z += SuperChunk::Z) {
-                if (this->chunks.count({ x, 0, z })) {
-                    this->chunks.at({ x, 0, z })->touch();
-                }
-            }
+        return generated;
+    }
+    
+    
+    void ChunkManager::mesh(GLboolean occlusionCulling) {
+        for (const auto &entry : this->chunks) {
+            entry.second->update(*this, occlusionCulling);
         }
-        return chunk;
     }
     
     
     void ChunkManager::clearChunks() {
         this->chunks.clear();
+        this->pool.clear();
     }
     
     
@@ -276,109 +183,78 @@ namespace cube {
     }
     
     
-    void ChunkManager::init() {
-        this->cubeShader = std::make_unique<shader::ShaderTexture>(
-            "../shader/cube.vs.glsl", "../shader/cube.fs.glsl"
-        );
-        this->cubeShader->addUniform("uMV", shader::UNIFORM_MATRIX_4F);
-        this->cubeShader->addUniform("uMVP", shader::UNIFORM_MATRIX_4F);
-        this->cubeShader->addUniform("uNormal", shader::UNIFORM_MATRIX_4F);
-        this->cubeShader->addUniform("uChunkPosition", shader::UNIFORM_3_F);
-        this->cubeShader->addUniform("uVerticalOffset", shader::UNIFORM_1_I);
-        this->cubeShader->addUniform("uLightPosition", shader::UNIFORM_3_F);
-        this->cubeShader->addUniform("uLightColor", shader::UNIFORM_3_F);
-        this->cubeShader->addUniform("uLightDirIntensity", shader::UNIFORM_1_F);
-        this->cubeShader->addUniform("uLightAmbIntensity", shader::UNIFORM_1_F);
+    const SuperChunkMap &ChunkManager::getSuperChunks() const {
+        return this->chunks;
     }
     
     
-    void ChunkManager::update() {
-        app::Stats *stats = app::Stats::getInstance();
-        
-        this->textureVerticalOffset = (this->textureVerticalOffset + 1) % 32;
-        
-        generateKeys();
+    SuperChunkMeshList ChunkManager::getMeshes() const {
+        SuperChunkMeshList meshes;
         
-        // Delete superChunk outside distanceView
-        std::vector<glm::ivec3> toErase;
+        meshes.reserve(this->chunks.size());
         for (const auto &entry : this->chunks) {
-            if (!std::count(this->keys.begin(), this->keys.end(), entry.first)) {
-                toErase.push_back(entry.first);
+            if (entry.second->getMesh()) {
+                meshes.push_back(entry.second->getMesh());
             }
         }
-        for (const auto &key : toErase) {
-            this->chunks.erase(key);
-        }
-        
-        // Add new superChunk that entered distanceView
-        std::for_each(
-            this->keys.begin(), this->keys.end(),
-            [this](const auto &key) {
-                if (!this->chunks.count(key)) {
-                    this->chunks.emplace(key, this->createSuperChunk(key));
-                }
-            }
-        );
         
+        return meshes;
+    }
+    
+    
+    const TerrainGenerator &ChunkManager::getGenerator() const {
+        return this->generator;
+    }
+    
+    
+    GLuint ChunkManager::getOccludedCount() const {
+        GLuint occluded = 0;
         
-        // Update superChunks
-        std::for_each(
-            this->chunks.begin(), this->chunks.end(),
-            [](const auto &entry) { entry.second->update(); }
-        );
+        for (const auto &entry : this->chunks) {
+            occluded += entry.second->getOccludedCount();
+        }
         
-        stats->l_superchunk = static_cast<GLuint>(this->chunks.size());
-        stats->l_chunk = stats->l_superchunk * SuperChunk::CHUNK_SIZE;
-        stats->l_cube = stats->l_superchunk * SuperChunk::SIZE;
-        stats->l_face = stats->l_cube * 6;
+        return occluded;
     }
     
     
-    void ChunkManager::render() {
-        app::Engine *engine = app::Engine::getInstance();
-        app::Config *config = app::Config::getInstance();
-        app::Stats *stats = app::Stats::getInstance();
+    GLuint64 ChunkManager::getSuperChunkBytes() const {
+        GLuint64 bytes = 0;
+        GLuint64 meshed = 0;
         
-        stats->r_superchunk = 0;
-        stats->r_chunk = 0;
-        stats->r_cube = 0;
-        stats->r_face = 0;
+        for (const auto &entry : this->chunks) {
+            if (entry.second->getMesh()) {
+                bytes += entry.second->getMeshBytes() + entry.second->getBufferBytes();
+                meshed++;
+            }
+        }
         
-        glm::mat4 MVMatrix = engine->camera->getViewMatrix();
-        glm::mat4 MVPMatrix = engine->camera->getProjMatrix() * MVMatrix;
-        glm::mat4 normalMatrix = glm::transpose(glm::inverse(MVMatrix));
+        return sizeof(SuperChunk) + (meshed ? bytes / meshed : 0);
+    }
+    
+    
+    MemoryUsage ChunkManager::getMemoryUsage() const {
+        MemoryUsage usage;
         
-        glm::vec3 lightPos = glm::vec3(MVMatrix * glm::vec4(engine->world->sun->getPosition(), 0));
-        glm::vec3 lightColor = config->getLightColor(engine->world->tickCycle);
-        if (engine->world->underwater) {
-            lightColor *= glm::vec3(0.36, 0.56, 1);
+        usage.voxels = (this->chunks.size() + this->pool.size()) * sizeof(SuperChunk);
+        for (const auto &entry : this->chunks) {
+            usage.meshes += entry.second->getMeshBytes();
+            usage.buffers += entry.second->getBufferBytes();
+        }
+        for (const SuperChunkMap::node_type &node : this->pool) {
+            usage.meshes += node.mapped()->getMeshBytes();
         }
-        GLfloat lightDirIntensity = config->getLightDirIntensity(engine->world->tickCycle);
-        GLfloat lightAmbIntensity = config->getLightAmbIntensity(engine->world->tickCycle);
-        
-        this->cubeShader->use();
-        this->cubeShader->loadUniform("uMV", glm::value_ptr(MVMatrix));
-        this->cubeShader->loadUniform("uMVP", glm::value_ptr(MVPMatrix));
-        this->cubeShader->loadUniform("uNormal", glm::value_ptr(normalMatrix));
-        this->cubeShader->loadUniform("uVerticalOffset", &this->textureVerticalOffset);
-        this->cubeShader->loadUniform("uLightPosition", glm::value_ptr(lightPos));
-        this->cubeShader->loadUniform("uLightColor", glm::value_ptr(lightColor));
-        this->cubeShader->loadUniform("uLightDirIntensity", &lightDirIntensity);
-        this->cubeShader->loadUniform("uLightAmbIntensity", &lightAmbIntensity);
-        this->cubeShader->bindTexture(this->cubeTexture);
-        config->getFaceCulling() ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
-        std::for_each(
-            this->chunks.begin(), this->chunks.end(),
-            [&stats](const auto &entry) { stats->r_face += entry.second->render(false); }
-        );
-        glDisable(GL_CULL_FACE);
-        std::for_each(
-            this->chunks.begin(), this->chunks.end(),
-            [&stats](const auto &entry) { stats->r_face += entry.second->render(true); }
-        );
-        glEnable(GL_CULL_FACE);
         
-        this->cubeShader->unbindTexture();
-        this->cubeShader->stop();
+        return usage;
+    }
+    
+    
+    GLboolean ChunkManager::isMemoryBound() const {
+        return this->memoryBound;
+    }
+    
+    
+    GLuint ChunkManager::getKeyCount() const {
+        return static_cast<GLuint>(this->keys.size());
     }
 }
@@ -0,0 +1,416 @@
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+#include <cube/ChunkRenderer.hpp>
+#include <app/Config.hpp>
+#include <app/Stats.hpp>
+#include <app/Profiler.hpp>
+
+
+namespace cube {
+    
+    ChunkRenderer::ChunkRenderer(const misc::Image *t_cubeTexture) :
+        cubeTexture(splitAtlas(t_cubeTexture)) {
+    }
+    
+    
+    std::vector<std::unique_ptr<misc::Image>> ChunkRenderer::splitAtlas(const misc::Image *atlas) {
+        std::vector<std::unique_ptr<misc::Image>> layers;
+        GLuint tileWidth = atlas->getWidth() / ATLAS_COLUMNS;
+        GLuint tileHeight = atlas->getHeight() / ATLAS_ROWS;
+        GLuint frameHeight = tileHeight / 2;
+        
+        layers.reserve(ATLAS_LAYERS);
+        
+        // One layer per face of every block, layer = x + ATLAS_COLUMNS * (y * 6 + face)
+        for (GLuint row = 0; row < ATLAS_BLOCK_ROWS * 6; row++) {
+            for (GLuint column = 0; column < ATLAS_COLUMNS; column++) {
+                layers.emplace_back(atlas->crop(column * tileWidth, row * tileHeight, tileWidth, tileHeight));
+            }
+        }
+        
+        // Animation frames are half a tile high, stretch them to the size of a layer
+        for (GLuint frame = 0; frame < ATLAS_FRAMES; frame++) {
+            std::unique_ptr<misc::Image> cropped(atlas->crop(0, frame * frameHeight, tileWidth, frameHeight));
+            layers.emplace_back(cropped->resize(tileWidth, tileHeight));
+        }
+        
+        return layers;
+    }
+    
+    
+    void ChunkRenderer::init() {
+        this->occlusionQueries = std::make_unique<OcclusionQueries>();
+        
+        // Macros defined in `cube.*.glsl` for each material, water is the only blended block and
+        // is animated
+        static const std::vector<std::string> defines[MATERIAL_COUNT] = {
+            { "OPAQUE" }, { "ALPHA_TEST" }, { "BLENDED", "ANIMATED" }
+        };
+        
+        for (GLuint material = 0; material < MATERIAL_COUNT; material++) {
+            this->cubeShaders[material] = std::make_unique<shader::ShaderTexture>(
+                "../shader/cube.vs.glsl", "../shader/cube.fs.glsl", defines[material]
+            );
+            this->uChunkPosition[material] = shader::Uniform<glm::vec3>(
+                *this->cubeShaders[material], "uChunkPosition"
+            );
+        }
+    }
+    
+    
+    void ChunkRenderer::update(const SuperChunkMeshList &meshes) {
+        this->updates++;
+        
+        // Move the buffers of unloaded superchunks to the pool, before the loaded ones need them
+        for (const auto &mesh : meshes) {
+            auto it = this->buffers.find(mesh->position);
+            if (it != this->buffers.end()) {
+                it->second->setUpdate(this->updates);
+            }
+        }
+        for (auto it = this->buffers.begin(); it != this->buffers.end();) {
+            if (it->second->getUpdate() == this->updates) {
+                it++;
+                continue;
+            }
+            auto next = std::next(it);
+            this->pool.push_back(this->buffers.extract(it));
+            it = next;
+        }
+        
+        for (const auto &mesh : meshes) {
+            auto it = this->buffers.find(mesh->position);
+            if (it == this->buffers.end() && this->pool.empty()) {
+                it = this->buffers.emplace(
+                    mesh->position, std::make_unique<SuperChunkBuffer>(mesh->position)
+                ).first;
+            }
+            else if (it == this->buffers.end()) {
+                SuperChunkBufferMap::node_type node = std::move(this->pool.back());
+                this->pool.pop_back();
+                node.key() = mesh->position;
+                node.mapped()->reset(mesh->position);
+                it = this->buffers.insert(std::move(node)).position;
+            }
+            it->second->setUpdate(this->updates);
+            it->second->upload(mesh, this->vertexArrays);
+        }
+        
+        // Enough to load a row and a column of superchunks, as kept by `cube::ChunkManager`
+        size_t maxPooled = 2 * static_cast<size_t>(std::ceil(std::sqrt(static_cast<GLfloat>(meshes.size()))));
+        if (this->pool.size() > maxPooled) {
+            this->pool.erase(this->pool.begin() + static_cast<std::ptrdiff_t>(maxPooled), this->pool.end());
+        }
+        
+        // Faces mostly appear and vanish around the surface, about a layer of chunks per superchunk
+        this->vertexArrays.trim(
+            static_cast<GLuint>(maxPooled) * SuperChunk::CHUNK_X * SuperChunk::CHUNK_Z * MATERIAL_COUNT
+        );
+    }
+    
+    
+    void ChunkRenderer::renderOpaque(const glm::vec3 &camera, const glm::mat4 &viewProjection) {
+        app::Config *config = app::Config::getInstance();
+        app::Stats *stats = app::Stats::getInstance();
+        
+        stats->r_superchunk = 0;
+        stats->r_chunk = 0;
+        stats->r_cube = 0;
+        stats->r_face = 0;
+        stats->occludedChunk = 0;
+        stats->occlusionQuery = 0;
+        stats->culledChunk = 0;
+        stats->sealedChunk = 0;
+        
+        {
+            app::Profiler::CpuScope cpuScope = app::Profiler::CpuScope(app::PHASE_VISIBILITY);
+            if (config->getCaveCulling()) {
+                stats->sealedChunk = this->walkVisibility(camera);
+            }
+            else {
+                for (const auto &entry : this->buffers) {
+                    entry.second->setReachable(true);
+                }
+            }
+        }
+        {
+            app::Profiler::CpuScope cpuScope = app::Profiler::CpuScope(app::PHASE_SOFTWARE_OCCLUSION);
+            if (config->getSoftwareOcclusion()) {
+                stats->culledChunk = this->cull(camera, viewProjection);
+            }
+            else {
+                for (const auto &entry : this->buffers) {
+                    entry.second->resetCulling();
+                }
+            }
+        }
+        
+        for (const auto &entry : this->buffers) {
+            if (config->getOcclusionQueries()) {
+                stats->occludedChunk += entry.second->readOcclusion();
+            }
+            else {
+                entry.second->resetOcclusion();
+            }
+            entry.second->countRendered();
+        }
+        
+        // Opaque and alpha-tested faces write depth without blending, like any opaque geometry
+        glDisable(GL_BLEND);
+        config->getFaceCulling() ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
+        {
+            app::Profiler::CpuScope cpuScope = app::Profiler::CpuScope(app::PHASE_OPAQUE);
+            app::Profiler::GpuScope gpuScope = app::Profiler::GpuScope(app::PHASE_OPAQUE);
+            this->collectDraws(MATERIAL_OPAQUE, camera);
+            stats->r_face += this->renderDraws(MATERIAL_OPAQUE, true, camera);
+        }
+        if (config->getOcclusionQueries()) {
+            app::Profiler::CpuScope cpuScope = app::Profiler::CpuScope(app::PHASE_OCCLUSION_QUERIES);
+            app::Profiler::GpuScope gpuScope = app::Profiler::GpuScope(app::PHASE_OCCLUSION_QUERIES);
+            stats->occlusionQuery = this->queryOcclusion(camera);
+            stats->r_face += this->renderDraws(MATERIAL_OPAQUE, false, camera);
+        }
+        // Back faces of foliage are seen through its transparent texels
+        glDisable(GL_CULL_FACE);
+        {
+            app::Profiler::CpuScope cpuScope = app::Profiler::CpuScope(app::PHASE_ALPHA_TEST);
+            app::Profiler::GpuScope gpuScope = app::Profiler::GpuScope(app::PHASE_ALPHA_TEST);
+            this->collectDraws(MATERIAL_ALPHA_TEST, camera);
+            stats->r_face += this->renderDraws(MATERIAL_ALPHA_TEST, true, camera);
+            stats->r_face += this->renderDraws(MATERIAL_ALPHA_TEST, false, camera);
+        }
+        glEnable(GL_BLEND);
+        glEnable(GL_CULL_FACE);
+        
+        this->cubeShaders[MATERIAL_ALPHA_TEST]->unbindTexture();
+        this->cubeShaders[MATERIAL_ALPHA_TEST]->stop();
+    }
+    
+    
+    void ChunkRenderer::renderTranslucent(const glm::vec3 &camera) {
+        app::Stats *stats = app::Stats::getInstance();
+        
+        // Translucent faces do not hide each other, they are blended back to front
+        glDisable(GL_CULL_FACE);
+        glDepthMask(GL_FALSE);
+        {
+            app::Profiler::CpuScope cpuScope = app::Profiler::CpuScope(app::PHASE_BLENDED);
+            app::Profiler::GpuScope gpuScope = app::Profiler::GpuScope(app::PHASE_BLENDED);
+            stats->r_face += this->renderBlended(camera);
+        }
+        glDepthMask(GL_TRUE);
+        glEnable(GL_CULL_FACE);
+        
+        this->cubeShaders[MATERIAL_BLENDED]->unbindTexture();
+        this->cubeShaders[MATERIAL_BLENDED]->stop();
+        this->frame++;
+    }
+    
+    
+    void ChunkRenderer::sortDraws(std::vector<SuperChunkBuffer::ChunkDraw> &draws,
+                                  std::vector<SuperChunkBuffer::ChunkDraw> &scratch) {
+        static constexpr GLuint DIGIT_BITS = 8;
+        static constexpr GLuint DIGIT_COUNT = sizeof(GLuint) * 8 / DIGIT_BITS;
+        static constexpr GLuint BUCKETS = 1u << DIGIT_BITS;
+        
+        if (draws.size() < 2) {
+            return;
+        }
+        
+        // Distances are positive floats, their bits are ordered like their values
+        auto key = [](const SuperChunkBuffer::ChunkDraw &draw) {
+            GLuint bits;
+            std::memcpy(&bits, &draw.distance, sizeof(bits));
+            return bits;
+        };
+        
+        GLuint counts[DIGIT_COUNT][BUCKETS] = {};
+        for (const SuperChunkBuffer::ChunkDraw &draw : draws) {
+            GLuint bits = key(draw);
+            for (GLuint digit = 0; digit < DIGIT_COUNT; digit++) {
+                counts[digit][(bits >> (digit * DIGIT_BITS)) & (BUCKETS - 1)]++;
+            }
+        }
+        
+        scratch.resize(draws.size());
+        for (GLuint digit = 0; digit < DIGIT_COUNT; digit++) {
+            GLuint shift = digit * DIGIT_BITS;
+            
+            // Nothing to do if every draw has the same digit, like the sign and high exponent bits
+            if (counts[digit][(key(draws.front()) >> shift) & (BUCKETS - 1)] == draws.size()) {
+                continue;
+            }
+            
+            GLuint offset = 0;
+            for (GLuint &count : counts[digit]) {
+                GLuint bucket = count;
+                count = offset;
+                offset += bucket;
+            }
+            for (const SuperChunkBuffer::ChunkDraw &draw : draws) {
+                scratch[counts[digit][(key(draw) >> shift) & (BUCKETS - 1)]++] = draw;
+            }
+            draws.swap(scratch);
+        }
+    }
+    
+    
+    void ChunkRenderer::collectDraws(Material material, const glm::vec3 &camera) {
+        std::vector<SuperChunkBuffer::ChunkDraw> &draws = this->draws[material];
+        
+        draws.clear();
+        for (const auto &entry : this->buffers) {
+            entry.second->getDraws(material, camera, draws);
+        }
+        sortDraws(draws, this->sortScratch);
+    }
+    
+    
+    GLuint ChunkRenderer::renderDraws(Material material, GLboolean visible, const glm::vec3 &camera) const {
+        const shader::ShaderTexture &shader = *this->cubeShaders[material];
+        // Faces looking away from the camera would be culled by the GPU anyway
+        bool rejectSides = material == MATERIAL_OPAQUE && app::Config::getInstance()->getFaceCulling();
+        GLubyte sides = SIDES_ALL;
+        GLuint rendered = 0;
+        
+        shader.use();
+        shader.bindTexture(this->cubeTexture);
+        for (const SuperChunkBuffer::ChunkDraw &draw : this->draws[material]) {
+            if (draw.buffer->isVisible() != visible) {
+                continue;
+            }
+            if (rejectSides) {
+                sides = ChunkBuffer::getFacingSides(draw.position, camera);
+            }
+            this->uChunkPosition[material].load(draw.position);
+            rendered += draw.buffer->render(material, sides);
+        }
+        
+        return rendered;
+    }
+    
+    
+    GLuint ChunkRenderer::queryOcclusion(const glm::vec3 &camera) {
+        GLuint issued = 0;
+        
+        this->occlusionQueries->begin();
+        for (const auto &entry : this->buffers) {
+            issued += entry.second->queryOcclusion(*this->occlusionQueries, camera, this->frame);
+        }
+        this->occlusionQueries->end();
+        
+        return issued;
+    }
+    
+    
+    GLuint ChunkRenderer::walkVisibility(const glm::vec3 &camera) {
+        static constexpr GLint OFFSETS[SIDE_COUNT][3] = {
+            { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }
+        };
+        static const glm::ivec3 superChunkSize = glm::ivec3(SuperChunk::X, SuperChunk::Y, SuperChunk::Z);
+        static const glm::ivec3 chunkCount = glm::ivec3(SuperChunk::CHUNK_X, SuperChunk::CHUNK_Y, SuperChunk::CHUNK_Z);
+        
+        glm::ivec3 origin = glm::ivec3(glm::floor(camera / glm::vec3(superChunkSize))) * superChunkSize;
+        glm::ivec3 chunk = glm::ivec3(glm::floor((camera - glm::vec3(origin)) / glm::vec3(Chunk::X, Chunk::Y, Chunk::Z)));
+        GLuint unreachable = 0;
+        
+        // Nothing to walk from if the camera is out of the loaded superchunks (eg. above the world)
+        auto it = this->buffers.find(origin);
+        bool walkable = it != this->buffers.end() && glm::all(glm::greaterThanEqual(chunk, glm::ivec3(0)))
+                        && glm::all(glm::lessThan(chunk, chunkCount));
+        for (const auto &entry : this->buffers) {
+            entry.second->setReachable(!walkable);
+        }
+        if (!walkable) {
+            return 0;
+        }
+        
+        this->walk.clear();
+        this->walk.push_back({ it->second.get(), chunk, SIDE_NEG_X, 0 });
+        it->second->getChunk(chunk).setReachable(true);
+        
+        for (std::size_t i = 0; i < this->walk.size(); i++) {
+            WalkStep step = this->walk[i];
+            const ChunkBuffer &current = step.superChunk->getChunk(step.chunk);
+            
+            for (GLuint s = 0; s < SIDE_COUNT; s++) {
+                auto side = static_cast<Side>(s);
+                auto opposite = static_cast<Side>(s ^ 1u);
+                
+                // Going back toward the camera cannot reveal anything the walk did not see
+                if (step.directions & (1u << opposite)) {
+                    continue;
+                }
+                if (step.directions && !current.connects(step.from, side)) {
+                    continue;
+                }
+                
+                SuperChunkBuffer *superChunk = step.superChunk;
+                glm::ivec3 next = step.chunk + glm::ivec3(OFFSETS[side][0], OFFSETS[side][1], OFFSETS[side][2]);
+                if (next.y < 0 || next.y >= SuperChunk::CHUNK_Y) {
+                    continue;
+                }
+                if (next.x < 0 || next.x >= SuperChunk::CHUNK_X || next.z < 0 || next.z >= SuperChunk::CHUNK_Z) {
+                    glm::ivec3 offset = glm::ivec3(OFFSETS[side][0], 0, OFFSETS[side][2]);
+                    auto neighbour = this->buffers.find(superChunk->getPosition() + offset * superChunkSize);
+                    if (neighbour == this->buffers.end()) {
+                        continue;
+                    }
+                    superChunk = neighbour->second.get();
+                    next -= offset * chunkCount;
+                }
+                
+                ChunkBuffer &buffer = superChunk->getChunk(next);
+                if (buffer.isReachable()) {
+                    continue;
+                }
+                buffer.setReachable(true);
+                this->walk.push_back({ superChunk, next, opposite, static_cast<GLubyte>(step.directions | 1u << side) });
+            }
+        }
+        
+        for (const auto &entry : this->buffers) {
+            unreachable += entry.second->getUnreachableCount();
+        }
+        
+        return unreachable;
+    }
+    
+    
+    GLuint ChunkRenderer::cull(const glm::vec3 &camera, const glm::mat4 &viewProjection) {
+        glm::ivec3 origin = glm::ivec3(glm::floor(camera / glm::vec3(SuperChunk::X, SuperChunk::Y, SuperChunk::Z)));
+        GLuint culled = 0;
+        
+        this->rasterizer.clear(viewProjection);
+        for (const auto &entry : this->buffers) {
+            glm::ivec3 distance = glm::abs(entry.first / glm::ivec3(SuperChunk::X, SuperChunk::Y, SuperChunk::Z) - origin);
+            if (distance.x <= OCCLUDER_DISTANCE && distance.z <= OCCLUDER_DISTANCE) {
+                entry.second->drawOccluders(this->rasterizer);
+            }
+        }
+        for (const auto &entry : this->buffers) {
+            culled += entry.second->cull(this->rasterizer);
+        }
+        
+        return culled;
+    }
+    
+    
+    GLuint ChunkRenderer::renderBlended(const glm::vec3 &camera) {
+        const shader::ShaderTexture &shader = *this->cubeShaders[MATERIAL_BLENDED];
+        GLuint rendered = 0;
+        
+        this->collectDraws(MATERIAL_BLENDED, camera);
+        
+        shader.use();
+        shader.bindTexture(this->cubeTexture);
+        for (auto it = this->draws[MATERIAL_BLENDED].rbegin(); it != this->draws[MATERIAL_BLENDED].rend(); it++) {
+            this->uChunkPosition[MATERIAL_BLENDED].load(it->position);
+            rendered += it->buffer->render(MATERIAL_BLENDED);
+        }
+        
+        return rendered;
+    }
+}
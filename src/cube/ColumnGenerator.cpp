@@ -1,6 +1,7 @@
 #include <stdexcept>
 
 #include <cube/ColumnGenerator.hpp>
+#include <cube/TerrainGenerator.hpp>
 
 
 namespace cube {
@@ -9,7 +10,7 @@ namespace cube {
         Column column = {};
         column.fill(cube::CubeData::AIR);
         
-        for (GLuint y = 0; y <= app::Config::GEN_WATER_LEVEL + 1; y++) {
+        for (GLuint y = 0; y <= TerrainGenerator::WATER_LEVEL + 1; y++) {
             if (y < height - 3) {
                 column[y] = cube::CubeData::STONE;
             }
@@ -29,14 +30,14 @@ namespace cube {
         Column column = {};
         column.fill(cube::CubeData::AIR);
         
-        for (GLuint y = 0; y <= app::Config::GEN_WATER_LEVEL + 1; y++) {
+        for (GLuint y = 0; y <= TerrainGenerator::WATER_LEVEL + 1; y++) {
             if (y < height - 3) {
                 column[y] = cube::CubeData::STONE;
             }
             else if (y < height) {
                 column[y] = cube::CubeData::SNOW;
             }
-            else if (y == app::Config::GEN_WATER_LEVEL + 1) {
+            else if (y == TerrainGenerator::WATER_LEVEL + 1) {
                 column[y] = cube::CubeData::ICE;
             }
             else {
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <cube/DepthRasterizer.hpp>
+
+
+namespace cube {
+    
+    /**
+     * Corners of each face of a box, counter-clockwise seen from outside. The bits of the index
+     * of a corner tell whether it is on the maximum side along x (1), y (2) and z (4).
+     */
+    static constexpr GLubyte BOX_FACES[6][4] = {
+        { 4, 5, 7, 6 }, // +Z
+        { 1, 0, 2, 3 }, // -Z
+        { 5, 1, 3, 7 }, // +X
+        { 0, 4, 6, 2 }, // -X
+        { 6, 7, 3, 2 }, // +Y
+        { 0, 1, 5, 4 }, // -Y
+    };
+    
+    
+    
+    DepthRasterizer::DepthRasterizer() :
+        depth(WIDTH * HEIGHT, FLT_MAX) {
+    }
+    
+    
+    static void projectCorners(const glm::mat4 &viewProjection, const glm::vec3 &min, const glm::vec3 &max,
+                               glm::vec4 *corners) {
+        for (GLuint i = 0; i < 8; i++) {
+            corners[i] = viewProjection * glm::vec4(
+                (i & 1u) ? max.x : min.x, (i & 2u) ? max.y : min.y, (i & 4u) ? max.z : min.z, 1.f
+            );
+        }
+    }
+    
+    
+    void DepthRasterizer::clear(const glm::mat4 &t_viewProjection) {
+        this->viewProjection = t_viewProjection;
+        std::fill(this->depth.begin(), this->depth.end(), FLT_MAX);
+    }
+    
+    
+    GLint DepthRasterizer::clipNear(const glm::vec4 *polygon, GLint count, glm::vec4 *clipped) {
+        GLint clippedCount = 0;
+        
+        // Sutherland-Hodgman against z >= -w, the near plane in clip space
+        for (GLint i = 0; i < count; i++) {
+            const glm::vec4 &a = polygon[i];
+            const glm::vec4 &b = polygon[(i + 1) % count];
+            GLfloat da = a.z + a.w;
+            GLfloat db = b.z + b.w;
+            
+            if (da >= 0) {
+                clipped[clippedCount++] = a;
+            }
+            if ((da >= 0) != (db >= 0)) {
+                clipped[clippedCount++] = a + (b - a) * (da / (da - db));
+            }
+        }
+        
+        return clippedCount;
+    }
+    
+    
+    void DepthRasterizer::drawPolygon(const glm::vec4 *polygon, GLint count) {
+        glm::vec3 screen[MAX_VERTICES];
+        GLfloat edgeA[MAX_VERTICES], edgeB[MAX_VERTICES], edgeC[MAX_VERTICES];
+        glm::vec2 min = glm::vec2(FLT_MAX), max = glm::vec2(-FLT_MAX);
+        GLfloat area = 0, planeArea = 0;
+        GLint plane = 1;
+        
+        for (GLint i = 0; i < count; i++) {
+            if (polygon[i].w <= 0) {
+                return;
+            }
+            screen[i] = glm::vec3(
+                (polygon[i].x / polygon[i].w * 0.5f + 0.5f) * WIDTH,
+                (polygon[i].y / polygon[i].w * 0.5f + 0.5f) * HEIGHT,
+                polygon[i].z / polygon[i].w
+            );
+            min = glm::min(min, glm::vec2(screen[i]));
+            max = glm::max(max, glm::vec2(screen[i]));
+        }
+        
+        // Area of the polygon, and the triangle fanned from the first vertex defining its plane
+        // the most accurately
+        for (GLint i = 1; i + 1 < count; i++) {
+            glm::vec2 u = glm::vec2(screen[i] - screen[0]);
+            glm::vec2 v = glm::vec2(screen[i + 1] - screen[0]);
+            GLfloat triangle = u.x * v.y - u.y * v.x;
+            area += triangle;
+            if (triangle > planeArea) {
+                planeArea = triangle;
+                plane = i;
+            }
+        }
+        // Facing away from the camera or degenerate
+        if (area <= 0 || planeArea <= 0) {
+            return;
+        }
+        
+        // Pixels whose center is inside the polygon, clamped before the conversion as vertices
+        // near the near plane can be far out of the screen
+        GLint x0 = static_cast<GLint>(std::ceil(std::max(min.x - 0.5f, 0.f)));
+        GLint x1 = static_cast<GLint>(std::floor(std::min(max.x - 0.5f, WIDTH - 1.f)));
+        GLint y0 = static_cast<GLint>(std::ceil(std::max(min.y - 0.5f, 0.f)));
+        GLint y1 = static_cast<GLint>(std::floor(std::min(max.y - 0.5f, HEIGHT - 1.f)));
+        if (x0 > x1 || y0 > y1) {
+            return;
+        }
+        x0 &= ~3;
+        
+        // A point is inside if edgeA * x + edgeB * y + edgeC >= 0 for every edge
+        for (GLint i = 0; i < count; i++) {
+            const glm::vec3 &a = screen[i];
+            const glm::vec3 &b = screen[(i + 1) % count];
+            edgeA[i] = a.y - b.y;
+            edgeB[i] = b.x - a.x;
+            edgeC[i] = -(edgeA[i] * a.x + edgeB[i] * a.y);
+        }
+        
+        // Depth is affine in screen space, raise it to its farthest value over each pixel so that
+        // occluders are never nearer than they are
+        glm::vec3 u = screen[plane] - screen[0];
+        glm::vec3 v = screen[plane + 1] - screen[0];
+        GLfloat depthA = (u.z * v.y - v.z * u.y) / planeArea;
+        GLfloat depthB = (v.z * u.x - u.z * v.x) / planeArea;
+        GLfloat depthC = screen[0].z - depthA * screen[0].x - depthB * screen[0].y;
+        depthC += 0.5f * (std::abs(depthA) + std::abs(depthB));
+        
+        for (GLint y = y0; y <= y1; y++) {
+            GLfloat cy = static_cast<GLfloat>(y) + 0.5f;
+            GLfloat *row = this->depth.data() + y * WIDTH;
+            GLfloat rowEdge[MAX_VERTICES];
+            GLfloat rowDepth = depthB * cy + depthC;
+            
+            for (GLint i = 0; i < count; i++) {
+                rowEdge[i] = edgeB[i] * cy + edgeC[i];
+            }
+
+#ifdef __SSE2__
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 offset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+            
+            for (GLint x = x0; x <= x1; x += 4) {
+                __m128 cx = _mm_add_ps(_mm_set1_ps(static_cast<GLfloat>(x)), offset);
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                
+                for (GLint i = 0; i < count; i++) {
+                    __m128 edge = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[i]), cx), _mm_set1_ps(rowEdge[i]));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(edge, zero));
+                }
+                
+                __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthA), cx), _mm_set1_ps(rowDepth));
+                __m128 current = _mm_loadu_ps(row + x);
+                __m128 nearest = _mm_min_ps(current, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+#else
+            for (GLint x = x0; x <= x1; x++) {
+                GLfloat cx = static_cast<GLfloat>(x) + 0.5f;
+                bool inside = true;
+                
+                for (GLint i = 0; i < count && inside; i++) {
+                    inside = edgeA[i] * cx + rowEdge[i] >= 0;
+                }
+                if (inside) {
+                    row[x] = std::min(row[x], depthA * cx + rowDepth);
+                }
+            }
+#endif
+        }
+    }
+    
+    
+    void DepthRasterizer::drawBox(const glm::vec3 &min, const glm::vec3 &max) {
+        glm::vec4 corners[8];
+        glm::vec4 face[4];
+        glm::vec4 clipped[MAX_VERTICES];
+        
+        projectCorners(this->viewProjection, min, max, corners);
+        
+        for (const GLubyte *indices : BOX_FACES) {
+            bool crossing = false;
+            
+            for (GLuint i = 0; i < 4; i++) {
+                face[i] = corners[indices[i]];
+                crossing |= face[i].z + face[i].w < 0;
+            }
+            
+            if (crossing) {
+                this->drawPolygon(clipped, clipNear(face, 4, clipped));
+            }
+            else {
+                this->drawPolygon(face, 4);
+            }
+        }
+    }
+    
+    
+    bool DepthRasterizer::isVisible(const glm::vec3 &min, const glm::vec3 &max) const {
+        glm::vec4 corners[8];
+        glm::vec2 screenMin = glm::vec2(FLT_MAX), screenMax = glm::vec2(-FLT_MAX);
+        GLfloat nearest = FLT_MAX;
+        GLuint inFront = 0;
+        
+        projectCorners(this->viewProjection, min, max, corners);
+        
+        for (const glm::vec4 &corner : corners) {
+            inFront += corner.z + corner.w >= 0 && corner.w > 0;
+        }
+        if (inFront == 0) {
+            return false;
+        }
+        // Crossing the near plane, the box surrounds the camera or is right in front of it
+        if (inFront < 8) {
+            return true;
+        }
+        
+        for (const glm::vec4 &corner : corners) {
+            glm::vec3 ndc = glm::vec3(corner) / corner.w;
+            screenMin = glm::min(screenMin, glm::vec2(ndc));
+            screenMax = glm::max(screenMax, glm::vec2(ndc));
+            nearest = std::min(nearest, ndc.z);
+        }
+        screenMin = (screenMin * 0.5f + 0.5f) * glm::vec2(WIDTH, HEIGHT);
+        screenMax = (screenMax * 0.5f + 0.5f) * glm::vec2(WIDTH, HEIGHT);
+        
+        // Every pixel the box overlaps, and one more on each side since occluders only cover the
+        // pixels whose center they contain
+        GLint x0 = static_cast<GLint>(std::floor(std::max(screenMin.x - 1.f, 0.f)));
+        GLint x1 = static_cast<GLint>(std::ceil(std::min(screenMax.x, WIDTH - 1.f)));
+        GLint y0 = static_cast<GLint>(std::floor(std::max(screenMin.y - 1.f, 0.f)));
+        GLint y1 = static_cast<GLint>(std::ceil(std::min(screenMax.y, HEIGHT - 1.f)));
+        if (x0 > x1 || y0 > y1) {
+            return false;
+        }
+        x0 &= ~3;
+        
+        for (GLint y = y0; y <= y1; y++) {
+            const GLfloat *row = this->depth.data() + y * WIDTH;
+
+#ifdef __SSE2__
+            const __m128 z = _mm_set1_ps(nearest);
+            
+            for (GLint x = x0; x <= x1; x += 4) {
+                if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), z))) {
+                    return true;
+                }
+            }
+#else
+            for (GLint x = x0; x <= x1; x++) {
+                if (row[x] >= nearest) {
+                    return true;
+                }
+            }
+#endif
+        }
+        
+        return false;
+    }
+}
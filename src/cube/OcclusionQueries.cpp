@@ -0,0 +1,87 @@
+#include <cube/OcclusionQueries.hpp>
+#include <cube/Chunk.hpp>
+
+
+namespace cube {
+    
+    OcclusionQueries::OcclusionQueries() :
+        shader(std::make_unique<shader::Shader>("../shader/occlusion.vs.glsl", "../shader/occlusion.fs.glsl")),
+        uChunkPosition(*this->shader, "uChunkPosition") {
+        const glm::vec3 min = glm::vec3(-MARGIN);
+        const glm::vec3 max = glm::vec3(Chunk::X, Chunk::Y, Chunk::Z) + MARGIN;
+        const glm::vec3 vertices[36] = {
+            // face
+            { min.x, min.y, max.z }, { max.x, min.y, max.z }, { max.x, max.y, max.z },
+            { max.x, max.y, max.z }, { min.x, max.y, max.z }, { min.x, min.y, max.z },
+            // top
+            { min.x, max.y, max.z }, { max.x, max.y, max.z }, { max.x, max.y, min.z },
+            { max.x, max.y, min.z }, { min.x, max.y, min.z }, { min.x, max.y, max.z },
+            // back
+            { max.x, min.y, min.z }, { min.x, min.y, min.z }, { min.x, max.y, min.z },
+            { min.x, max.y, min.z }, { max.x, max.y, min.z }, { max.x, min.y, min.z },
+            // bottom
+            { min.x, min.y, min.z }, { max.x, min.y, min.z }, { max.x, min.y, max.z },
+            { max.x, min.y, max.z }, { min.x, min.y, max.z }, { min.x, min.y, min.z },
+            // left
+            { min.x, min.y, min.z }, { min.x, min.y, max.z }, { min.x, max.y, max.z },
+            { min.x, max.y, max.z }, { min.x, max.y, min.z }, { min.x, min.y, min.z },
+            // right
+            { max.x, min.y, max.z }, { max.x, min.y, min.z }, { max.x, max.y, min.z },
+            { max.x, max.y, min.z }, { max.x, max.y, max.z }, { max.x, min.y, max.z },
+        };
+        
+        glGenBuffers(1, &this->vbo);
+        glGenVertexArrays(1, &this->vao);
+        
+        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        
+        glBindVertexArray(this->vao);
+        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+        glEnableVertexAttribArray(VERTEX_ATTR_POSITION);
+        glVertexAttribPointer(
+            VERTEX_ATTR_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+    
+    
+    OcclusionQueries::~OcclusionQueries() {
+        glDeleteBuffers(1, &this->vbo);
+        glDeleteVertexArrays(1, &this->vao);
+    }
+    
+    
+    void OcclusionQueries::begin() const {
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+        this->shader->use();
+        glBindVertexArray(this->vao);
+    }
+    
+    
+    void OcclusionQueries::end() const {
+        glBindVertexArray(0);
+        this->shader->stop();
+        glDepthMask(GL_TRUE);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
+    
+    
+    void OcclusionQueries::query(ChunkBuffer &buffer, const glm::vec3 &position) const {
+        this->uChunkPosition.load(position);
+        buffer.beginQuery();
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+        buffer.endQuery();
+    }
+    
+    
+    bool OcclusionQueries::contains(const glm::vec3 &position, const glm::vec3 &camera) {
+        glm::vec3 min = position - INSIDE_MARGIN;
+        glm::vec3 max = position + glm::vec3(Chunk::X, Chunk::Y, Chunk::Z) + INSIDE_MARGIN;
+        
+        return glm::all(glm::greaterThanEqual(camera, min)) && glm::all(glm::lessThanEqual(camera, max));
+    }
+}
@@ -1,15 +1,27 @@
-#include <iostream>
-
-#include <glm/ext.hpp>
+#include <cassert>
 
 #include <cube/SuperChunk.hpp>
-#include <app/Engine.hpp>
 
 
 namespace cube {
     
-    SuperChunk::SuperChunk(glm::ivec3 t_position) :
-        position(t_position), modified(true), count(0) {
+    SuperChunk::SuperChunk(glm::ivec3 t_position) {
+        this->reset(t_position);
+    }
+    
+    
+    SuperChunk::SuperChunk(GLuint x, GLuint y, GLuint z) :
+        SuperChunk(glm::ivec3(x, y, z)) {
+    }
+    
+    
+    void SuperChunk::reset(glm::ivec3 t_position) {
+        this->position = t_position;
+        this->modified = true;
+        this->count = 0;
+        this->occludedCount = 0;
+        this->bufferBytes = 0;
+        this->mesh = nullptr;
         
         for (GLint x = 0; x < CHUNK_X; x++) {
             for (GLint y = 0; y < CHUNK_Y; y++) {
@@ -18,18 +30,14 @@ namespace cube {
                         t_position.x + (x * Chunk::X), t_position.y + (y * Chunk::Y),
                         t_position.z + (z * Chunk::Z)
                     );
+                    this->chunks[x][y][z].touch();
                 }
             }
         }
     }
     
     
-    SuperChunk::SuperChunk(GLuint x, GLuint y, GLuint z) :
-        SuperChunk(glm::ivec3(x, y, z)) {
-    }
-    
-    
-    CubeData SuperChunk::get(GLuint x, GLuint y, GLuint z) {
+    CubeData SuperChunk::get(GLuint x, GLuint y, GLuint z) const {
         assert(x < X);
         assert(y < Y);
         assert(z < Z);
@@ -64,52 +72,95 @@ namespace cube {
     }
     
     
-    GLuint SuperChunk::update() {
+    GLuint SuperChunk::update(const IVoxelSource &world, GLboolean occlusionCulling) {
         if (!modified) {
             return this->count;
         }
         
+        std::shared_ptr<SuperChunkMesh> mesh = std::make_shared<SuperChunkMesh>();
+        
         this->count = 0;
+        this->occludedCount = 0;
+        this->meshBytes = 0;
         
         for (GLubyte x = 0; x < CHUNK_X; x++) {
             for (GLubyte y = 0; y < CHUNK_Y; y++) {
                 for (GLubyte z = 0; z < CHUNK_Z; z++) {
-                    this->count += this->chunks[x][y][z].update();
+                    this->count += this->chunks[x][y][z].update(world, occlusionCulling);
+                    this->occludedCount += this->chunks[x][y][z].getMesh()->occludedCount;
+                    mesh->chunks[x][y][z] = this->chunks[x][y][z].getMesh();
+                    this->meshBytes += mesh->chunks[x][y][z]->getByteSize();
                 }
             }
         }
         
+        this->computeOccluders(*mesh);
+        mesh->position = this->position;
+        mesh->count = this->count;
+        this->bufferBytes = static_cast<GLuint64>(this->count) * sizeof(CubeFace);
+        this->mesh = mesh;
         this->modified = false;
         return this->count;
     }
     
     
-    GLuint SuperChunk::render(bool alpha) {
-        assert(!modified);
-        
-        if (this->count == 0) {
-            return 0;
-        }
-        
-        GLuint rendered = 0;
-        glm::vec3 position;
-        app::Engine *engine = app::Engine::getInstance();
-        for (GLubyte x = 0; x < CHUNK_X; x++) {
-            for (GLubyte y = 0; y < CHUNK_Y; y++) {
-                for (GLubyte z = 0; z < CHUNK_Z; z++) {
-                    position = glm::ivec3(
-                        x * Chunk::X + this->position.x,
-                        y * Chunk::Y + this->position.y,
-                        z * Chunk::Z + this->position.z
-                    );
-                    engine->world->chunkManager->cubeShader->loadUniform(
-                        "uChunkPosition", glm::value_ptr(position)
-                    );
-                    rendered += this->chunks[x][y][z].render(alpha);
+    void SuperChunk::computeOccluders(SuperChunkMesh &mesh) const {
+        for (GLuint ox = 0; ox < OCCLUDER_X; ox++) {
+            for (GLuint oz = 0; oz < OCCLUDER_Z; oz++) {
+                GLuint height = Y;
+                
+                // Lowest column of the square, a box must never cover a visible block
+                for (GLuint x = ox * OCCLUDER_SIZE; x < (ox + 1) * OCCLUDER_SIZE && height; x++) {
+                    for (GLuint z = oz * OCCLUDER_SIZE; z < (oz + 1) * OCCLUDER_SIZE && height; z++) {
+                        GLuint y = 0;
+                        while (y < height && !(this->get(x, y, z) & ALPHA)) {
+                            y++;
+                        }
+                        height = y;
+                    }
                 }
+                
+                mesh.occluders[ox][oz] = static_cast<GLushort>(height);
             }
         }
+    }
+    
+    
+    const Chunk &SuperChunk::getChunk(GLuint x, GLuint y, GLuint z) const {
+        assert(x < CHUNK_X);
+        assert(y < CHUNK_Y);
+        assert(z < CHUNK_Z);
         
-        return rendered;
+        return this->chunks[x][y][z];
+    }
+    
+    
+    const std::shared_ptr<const SuperChunkMesh> &SuperChunk::getMesh() const {
+        return this->mesh;
+    }
+    
+    
+    glm::ivec3 SuperChunk::getPosition() const {
+        return this->position;
+    }
+    
+    
+    GLuint SuperChunk::getCount() const {
+        return this->count;
+    }
+    
+    
+    GLuint SuperChunk::getOccludedCount() const {
+        return this->occludedCount;
+    }
+    
+    
+    GLuint64 SuperChunk::getMeshBytes() const {
+        return this->meshBytes;
+    }
+    
+    
+    GLuint64 SuperChunk::getBufferBytes() const {
+        return this->bufferBytes;
     }
 }
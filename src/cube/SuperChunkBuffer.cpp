@@ -0,0 +1,275 @@
+#include <cassert>
+
+#include <cube/SuperChunkBuffer.hpp>
+#include <app/Stats.hpp>
+
+
+namespace cube {
+    
+    SuperChunkBuffer::SuperChunkBuffer(glm::ivec3 t_position) :
+        position(t_position) {
+    }
+    
+    
+    void SuperChunkBuffer::reset(glm::ivec3 t_position) {
+        this->position = t_position;
+        this->count = 0;
+        this->culled = false;
+        this->mesh = nullptr;
+        
+        for (auto &plane : this->buffers) {
+            for (auto &row : plane) {
+                for (ChunkBuffer &buffer : row) {
+                    buffer.reset();
+                }
+            }
+        }
+    }
+    
+    
+    void SuperChunkBuffer::upload(const std::shared_ptr<const SuperChunkMesh> &mesh, VertexArrayPool &pool) {
+        // The superchunk was not meshed again since the last upload
+        if (mesh == this->mesh) {
+            return;
+        }
+        
+        this->mesh = mesh;
+        this->count = mesh->count;
+        
+        for (GLuint x = 0; x < SuperChunk::CHUNK_X; x++) {
+            for (GLuint y = 0; y < SuperChunk::CHUNK_Y; y++) {
+                for (GLuint z = 0; z < SuperChunk::CHUNK_Z; z++) {
+                    this->buffers[x][y][z].upload(*mesh->chunks[x][y][z], pool);
+                }
+            }
+        }
+    }
+    
+    
+    void SuperChunkBuffer::setUpdate(GLuint64 t_update) {
+        this->update = t_update;
+    }
+    
+    
+    GLuint64 SuperChunkBuffer::getUpdate() const {
+        return this->update;
+    }
+    
+    
+    void SuperChunkBuffer::countRendered() const {
+        if (this->count == 0 || this->culled) {
+            return;
+        }
+        
+        app::Stats *stats = app::Stats::getInstance();
+        
+        stats->r_superchunk++;
+        for (const auto &plane : this->buffers) {
+            for (const auto &row : plane) {
+                for (const ChunkBuffer &buffer : row) {
+                    if (!buffer.isSkipped() && buffer.isVisible() && buffer.getCubeCount()) {
+                        stats->r_chunk++;
+                        stats->r_cube += buffer.getCubeCount();
+                    }
+                }
+            }
+        }
+    }
+    
+    
+    void SuperChunkBuffer::getDraws(Material material, const glm::vec3 &camera, std::vector<ChunkDraw> &draws) const {
+        if (this->count == 0 || this->culled) {
+            return;
+        }
+        
+        glm::vec3 position;
+        glm::vec3 center;
+        for (GLubyte x = 0; x < SuperChunk::CHUNK_X; x++) {
+            for (GLubyte y = 0; y < SuperChunk::CHUNK_Y; y++) {
+                for (GLubyte z = 0; z < SuperChunk::CHUNK_Z; z++) {
+                    if (this->buffers[x][y][z].isSkipped() || !this->buffers[x][y][z].getFaceCount(material)) {
+                        continue;
+                    }
+                    position = glm::ivec3(
+                        x * Chunk::X + this->position.x,
+                        y * Chunk::Y + this->position.y,
+                        z * Chunk::Z + this->position.z
+                    );
+                    center = position + glm::vec3(Chunk::X, Chunk::Y, Chunk::Z) / 2.f - camera;
+                    draws.push_back({ &this->buffers[x][y][z], position, glm::dot(center, center) });
+                }
+            }
+        }
+    }
+    
+    
+    GLuint SuperChunkBuffer::readOcclusion() {
+        GLuint hidden = 0;
+        
+        for (auto &plane : this->buffers) {
+            for (auto &row : plane) {
+                for (ChunkBuffer &buffer : row) {
+                    buffer.readQuery();
+                    hidden += !buffer.isEmpty() && !buffer.isSkipped() && !buffer.isVisible();
+                }
+            }
+        }
+        
+        return hidden;
+    }
+    
+    
+    void SuperChunkBuffer::resetOcclusion() {
+        for (auto &plane : this->buffers) {
+            for (auto &row : plane) {
+                for (ChunkBuffer &buffer : row) {
+                    buffer.setVisible();
+                }
+            }
+        }
+    }
+    
+    
+    GLuint SuperChunkBuffer::queryOcclusion(const OcclusionQueries &queries, const glm::vec3 &camera,
+                                            GLuint64 frame) {
+        if (this->count == 0 || this->culled) {
+            return 0;
+        }
+        
+        GLuint issued = 0;
+        glm::vec3 position;
+        for (GLubyte x = 0; x < SuperChunk::CHUNK_X; x++) {
+            for (GLubyte y = 0; y < SuperChunk::CHUNK_Y; y++) {
+                for (GLubyte z = 0; z < SuperChunk::CHUNK_Z; z++) {
+                    ChunkBuffer &buffer = this->buffers[x][y][z];
+                    if (buffer.isEmpty() || buffer.isSkipped()) {
+                        continue;
+                    }
+                    
+                    position = glm::ivec3(
+                        x * Chunk::X + this->position.x,
+                        y * Chunk::Y + this->position.y,
+                        z * Chunk::Z + this->position.z
+                    );
+                    if (OcclusionQueries::contains(position, camera)) {
+                        buffer.setVisible();
+                    }
+                    // Offset the frame of each chunk so that queries of visible chunks are spread
+                    // over `ChunkBuffer::QUERY_INTERVAL` frames
+                    else if (buffer.needsQuery(frame + x + y + z)) {
+                        queries.query(buffer, position);
+                        issued++;
+                    }
+                }
+            }
+        }
+        
+        return issued;
+    }
+    
+    
+    void SuperChunkBuffer::drawOccluders(DepthRasterizer &rasterizer) const {
+        if (!this->mesh) {
+            return;
+        }
+        
+        glm::vec3 min;
+        for (GLuint x = 0; x < SuperChunk::OCCLUDER_X; x++) {
+            for (GLuint z = 0; z < SuperChunk::OCCLUDER_Z; z++) {
+                if (!this->mesh->occluders[x][z]) {
+                    continue;
+                }
+                min = this->position + glm::ivec3(x * SuperChunk::OCCLUDER_SIZE, 0, z * SuperChunk::OCCLUDER_SIZE);
+                rasterizer.drawBox(
+                    min, min + glm::vec3(SuperChunk::OCCLUDER_SIZE, this->mesh->occluders[x][z], SuperChunk::OCCLUDER_SIZE)
+                );
+            }
+        }
+    }
+    
+    
+    GLuint SuperChunkBuffer::cull(const DepthRasterizer &rasterizer) {
+        GLuint culledCount = 0;
+        glm::vec3 position;
+        
+        this->culled = this->count == 0 || !rasterizer.isVisible(
+            this->position, glm::vec3(this->position) + glm::vec3(SuperChunk::X, SuperChunk::Y, SuperChunk::Z)
+        );
+        
+        for (GLubyte x = 0; x < SuperChunk::CHUNK_X; x++) {
+            for (GLubyte y = 0; y < SuperChunk::CHUNK_Y; y++) {
+                for (GLubyte z = 0; z < SuperChunk::CHUNK_Z; z++) {
+                    ChunkBuffer &buffer = this->buffers[x][y][z];
+                    if (buffer.isEmpty() || !buffer.isReachable()) {
+                        buffer.setCulled(false);
+                        continue;
+                    }
+                    
+                    position = glm::ivec3(
+                        x * Chunk::X + this->position.x,
+                        y * Chunk::Y + this->position.y,
+                        z * Chunk::Z + this->position.z
+                    );
+                    buffer.setCulled(
+                        this->culled || !rasterizer.isVisible(position, position + glm::vec3(Chunk::X, Chunk::Y, Chunk::Z))
+                    );
+                    culledCount += buffer.isCulled();
+                }
+            }
+        }
+        
+        return culledCount;
+    }
+    
+    
+    void SuperChunkBuffer::resetCulling() {
+        this->culled = false;
+        for (auto &plane : this->buffers) {
+            for (auto &row : plane) {
+                for (ChunkBuffer &buffer : row) {
+                    buffer.setCulled(false);
+                }
+            }
+        }
+    }
+    
+    
+    void SuperChunkBuffer::setReachable(GLboolean reachable) {
+        for (auto &plane : this->buffers) {
+            for (auto &row : plane) {
+                for (ChunkBuffer &buffer : row) {
+                    buffer.setReachable(reachable);
+                }
+            }
+        }
+    }
+    
+    
+    GLuint SuperChunkBuffer::getUnreachableCount() const {
+        GLuint unreachable = 0;
+        
+        for (const auto &plane : this->buffers) {
+            for (const auto &row : plane) {
+                for (const ChunkBuffer &buffer : row) {
+                    unreachable += !buffer.isEmpty() && !buffer.isReachable();
+                }
+            }
+        }
+        
+        return unreachable;
+    }
+    
+    
+    ChunkBuffer &SuperChunkBuffer::getChunk(const glm::ivec3 &chunk) {
+        assert(chunk.x >= 0 && chunk.x < SuperChunk::CHUNK_X);
+        assert(chunk.y >= 0 && chunk.y < SuperChunk::CHUNK_Y);
+        assert(chunk.z >= 0 && chunk.z < SuperChunk::CHUNK_Z);
+        
+        return this->buffers[chunk.x][chunk.y][chunk.z];
+    }
+    
+    
+    glm::ivec3 SuperChunkBuffer::getPosition() const {
+        return this->position;
+    }
+}
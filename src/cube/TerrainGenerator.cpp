@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#include <effolkronium/random.hpp>
+
+#include <cube/TerrainGenerator.hpp>
+#include <cube/ColumnGenerator.hpp>
+#include <cube/TreeGenerator.hpp>
+#include <misc/Trace.hpp>
+
+
+using Random = effolkronium::random_static;
+
+namespace cube {
+    
+    TerrainGenerator::TerrainGenerator() :
+        temperatureNoise(
+            { Random::get<float>(0., 100000.), Random::get<float>(0., 100000.) }, 5, 1.f, 1 / 258.f,
+            0.5f, 2.f
+        ),
+        
+        carvingNoise(
+            {
+                Random::get<float>(0., 100000.), Random::get<float>(0., 100000.),
+                Random::get<float>(0., 100000.)
+            },
+            3, 1.f, 1 / 64.f, 0.5f, 2.f
+        ),
+        
+        heightNoise({ Random::get<float>(0., 100000.), Random::get<float>(0., 100000.) }, 3, 1.f,
+                    1 / 256.f, 0.5f, 2.f
+        ) {
+    }
+    
+    
+    CubeData TerrainGenerator::getBiome(GLuint height, GLfloat temperature) {
+        assert(height >= MIN_H);
+        assert(height <= MAX_H);
+        
+        static constexpr GLubyte sandLevel = WATER_LEVEL + 3;
+        static constexpr GLubyte dirtLevel = sandLevel + 18;
+        static constexpr GLubyte stoneLevel = dirtLevel + 4;
+        
+        if (temperature < -0.30f) { // Snow biome
+            if (height <= WATER_LEVEL) {
+                return CubeData::ICE;
+            }
+            if (height <= sandLevel) {
+                return CubeData::SNOW;
+            }
+            if (height <= dirtLevel) {
+                return CubeData::DIRT_SNOW;
+            }
+            if (height <= stoneLevel) {
+                return CubeData::STONE_SNOW;
+            }
+            return CubeData::SNOW;
+        }
+        else if (temperature < -0.125f || (temperature > 0.125f && temperature < 0.30f)) {
+            // Plain biome
+            if (height <= WATER_LEVEL) {
+                return CubeData::WATER;
+            }
+            if (height <= sandLevel) {
+                return CubeData::SAND_BEACH;
+            }
+            if (height <= dirtLevel) {
+                return CubeData::DIRT_PLAIN;
+            }
+            if (height <= stoneLevel) {
+                return CubeData::STONE;
+            }
+            return CubeData::STONE_SNOW;
+        }
+        else if (temperature < 0.125f) { // Jungle biome
+            if (height <= WATER_LEVEL) {
+                return CubeData::WATER;
+            }
+            if (height <= sandLevel) {
+                return CubeData::DIRT_JUNGLE;
+            }
+            if (height <= dirtLevel) {
+                return CubeData::DIRT_JUNGLE;
+            }
+            if (height <= stoneLevel) {
+                return CubeData::STONE;
+            }
+            return CubeData::STONE;
+        }
+        // Desert biome
+        if (height <= WATER_LEVEL) {
+            return CubeData::WATER;
+        }
+        if (height <= sandLevel) {
+            return CubeData::SAND_BEACH;
+        }
+        if (height <= dirtLevel) {
+            return CubeData::SAND_DESERT;
+        }
+        if (height <= stoneLevel) {
+            return CubeData::SAND_DESERT;
+        }
+        return CubeData::STONE;
+    }
+    
+    
+    void TerrainGenerator::shape(SuperChunk &chunk) const {
+        glm::ivec3 position = chunk.getPosition();
+        GLubyte height;
+        GLuint x, y, z;
+        
+        // Set eight of each column
+        for (x = 0; x < SuperChunk::X; x++) {
+            for (z = 0; z < SuperChunk::Z; z++) {
+                height = static_cast<GLubyte>(this->heightNoise(
+                    { position.x + GLint(x), position.z + GLint(z) }, -1, 1,
+                    MIN_H, MAX_H
+                ));
+                for (y = 0; y <= height; y++) {
+                    chunk.set(x, y, z, CubeData::STONE);
+                }
+                for (y = height + 1; y < SuperChunk::Y; y++) {
+                    chunk.set(x, y, z, CubeData::AIR);
+                }
+            }
+        }
+    }
+    
+    
+    void TerrainGenerator::carve(SuperChunk &chunk) const {
+        glm::ivec3 position = chunk.getPosition();
+        glm::vec3 point;
+        GLuint x, y, z;
+        
+        // Create more unusual terrain by subtracting 3D noise
+        for (x = 0; x < SuperChunk::X; x++) {
+            for (y = CARVING_H; y < MAX_H; y++) {
+                for (z = 0; z < SuperChunk::Z; z++) {
+                    point = { position.x + GLint(x), position.y + GLint(y), position.z + GLint(z) };
+                    if (this->carvingNoise(point) > 0.f) {
+                        chunk.set(x, y, z, CubeData::AIR);
+                    }
+                }
+            }
+        }
+    }
+    
+    
+    void TerrainGenerator::paint(SuperChunk &chunk) const {
+        glm::ivec3 position = chunk.getPosition();
+        std::array<CubeData, SuperChunk::Y> column {};
+        CubeData biome;
+        float temperature;
+        GLuint x, y, z, y2;
+        
+        // Generate biome over terrain
+        for (x = 0; x < SuperChunk::X; x++) {
+            for (z = 0; z < SuperChunk::Z; z++) {
+                for (y = MAX_H; y >= MIN_H; y--) {
+                    if (chunk.get(x, y, z) != CubeData::AIR) {
+                        temperature = this->temperatureNoise(
+                            { position.x + GLint(x), position.z + GLint(z) }
+                        );
+                        biome = TerrainGenerator::getBiome(y, temperature);
+                        column = ColumnGenerator::generate(y, biome);
+                        for (y2 = MIN_H; y2 <= MAX_H; y2++) {
+                            chunk.set(x, y2, z, column[y2]);
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    
+    
+    void TerrainGenerator::plant(SuperChunk &chunk) {
+        CubeData biome;
+        GLuint x, y, z;
+        
+        // Generate Tree or slimes on certain position
+        for (x = 0; x < SuperChunk::X; x++) {
+            for (z = 0; z < SuperChunk::Z; z++) {
+                for (y = MAX_H; y >= MIN_H; y--) {
+                    if (!(chunk.get(x, y, z) & NOT_FLOOR)) {
+                        biome = chunk.get(x, y, z);
+                        
+                        // Try to generate a tree at position
+                        Tree tree = TreeGenerator::generate({ x, y, z }, biome);
+                        if (!tree.empty()) { // If a tree was generated
+                            std::for_each(
+                                tree.begin(), tree.end(),
+                                [&chunk](const auto &e) {
+                                    chunk.set(
+                                        static_cast<GLuint>(e.first.x),
+                                        static_cast<GLuint>(e.first.y),
+                                        static_cast<GLuint>(e.first.z),
+                                        e.second
+                                    );
+                                }
+                            );
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    
+    
+    void TerrainGenerator::generate(SuperChunk &chunk) const {
+        TRACE_SCOPE_POS("TerrainGenerator::generate", chunk.getPosition());
+        
+        this->shape(chunk);
+        this->carve(chunk);
+        this->paint(chunk);
+        TerrainGenerator::plant(chunk);
+    }
+}
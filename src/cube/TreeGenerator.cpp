@@ -3,7 +3,7 @@
 #include <effolkronium/random.hpp>
 
 #include <cube/TreeGenerator.hpp>
-#include <app/Engine.hpp>
+#include <cube/SuperChunk.hpp>
 
 
 using Random = effolkronium::random_static;
@@ -0,0 +1,57 @@
+#include <cube/VertexArrayPool.hpp>
+#include <app/Stats.hpp>
+
+
+namespace cube {
+    
+    VertexArrayPool::~VertexArrayPool() {
+        glDeleteBuffers(static_cast<GLsizei>(this->vbos.size()), this->vbos.data());
+        glDeleteVertexArrays(static_cast<GLsizei>(this->vaos.size()), this->vaos.data());
+        app::Stats::getInstance()->glObject -= static_cast<GLuint>(this->vbos.size() + this->vaos.size());
+    }
+    
+    
+    bool VertexArrayPool::acquire(GLuint &vbo, GLuint &vao) {
+        if (this->vbos.empty()) {
+            return false;
+        }
+        
+        vbo = this->vbos.back();
+        vao = this->vaos.back();
+        this->vbos.pop_back();
+        this->vaos.pop_back();
+        
+        return true;
+    }
+    
+    
+    void VertexArrayPool::release(GLuint vbo, GLuint vao) {
+        // Free the storage of the buffer, only the names are kept
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        
+        this->vbos.push_back(vbo);
+        this->vaos.push_back(vao);
+    }
+    
+    
+    void VertexArrayPool::trim(GLuint size) {
+        if (this->vbos.size() <= size) {
+            return;
+        }
+        
+        GLsizei extra = static_cast<GLsizei>(this->vbos.size() - size);
+        glDeleteBuffers(extra, this->vbos.data() + size);
+        glDeleteVertexArrays(extra, this->vaos.data() + size);
+        this->vbos.resize(size);
+        this->vaos.resize(size);
+        
+        app::Stats::getInstance()->glObject -= static_cast<GLuint>(extra * 2);
+    }
+    
+    
+    GLuint VertexArrayPool::getSize() const {
+        return static_cast<GLuint>(this->vbos.size());
+    }
+}
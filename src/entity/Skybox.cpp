@@ -1,42 +1,26 @@
 #include <iostream>
 
-#include <glm/gtc/type_ptr.hpp>
-
 #include <entity/Skybox.hpp>
-#include <app/Engine.hpp>
+#include <misc/AssetLoader.hpp>
 
 
 namespace entity {
     
     Skybox::Skybox() :
         vbo(0), vao(0) {
-        std::unique_ptr<misc::Image> texture[6] = {
-            std::unique_ptr<misc::Image>(
-                misc::Image::loadPNG("../assets/entity/skybox/negative_right.png")
-            ),
-            std::unique_ptr<misc::Image>(
-                misc::Image::loadPNG("../assets/entity/skybox/negative_left.png")
-            ),
-            std::unique_ptr<misc::Image>(
-                misc::Image::loadPNG("../assets/entity/skybox/negative_top.png")
-            ),
-            std::unique_ptr<misc::Image>(
-                misc::Image::loadPNG("../assets/entity/skybox/negative_bottom.png")
-            ),
-            std::unique_ptr<misc::Image>(
-                misc::Image::loadPNG("../assets/entity/skybox/negative_back.png")
-            ),
-            std::unique_ptr<misc::Image>(
-                misc::Image::loadPNG("../assets/entity/skybox/negative_front.png")
-            ),
-        };
-        this->negativeSky = std::make_unique<shader::Cubemap>(texture);
+        std::vector<std::unique_ptr<misc::Image>> texture = misc::AssetLoader::getInstance()->loadImages({
+            "../assets/entity/skybox/negative_right.png",
+            "../assets/entity/skybox/negative_left.png",
+            "../assets/entity/skybox/negative_top.png",
+            "../assets/entity/skybox/negative_bottom.png",
+            "../assets/entity/skybox/negative_back.png",
+            "../assets/entity/skybox/negative_front.png",
+        });
+        this->negativeSky = std::make_unique<shader::Cubemap>(texture.data());
         
         this->shader = std::make_unique<shader::ShaderCubemap>(
             "../shader/skybox.vs.glsl", "../shader/skybox.fs.glsl"
         );
-        this->shader->addUniform("uMVP", shader::UNIFORM_MATRIX_4F);
-        this->shader->addUniform("uSkyColor", shader::UNIFORM_3_F);
         
         glGenBuffers(1, &this->vbo);
         glGenVertexArrays(1, &this->vao);
@@ -65,21 +49,9 @@ namespace entity {
     
     
     GLuint Skybox::render() {
-        app::Engine *engine = app::Engine::getInstance();
-        app::Config *config = app::Config::getInstance();
-        
-        // Remove translation from the MV
-        glm::mat4 MVMatrix = glm::mat4(glm::mat3(engine->camera->getViewMatrix()));
-        glm::mat4 MVPMatrix = engine->camera->getProjMatrix() * MVMatrix;
-        
+        // The matrix and the color of the sky come from the `Frame` uniform block
         glCullFace(GL_FRONT);
         this->shader->use();
-        this->shader->loadUniform("uMVP", glm::value_ptr(MVPMatrix));
-        this->shader->loadUniform(
-            "uSkyColor", glm::value_ptr(config->getSkyboxColor(
-                static_cast<GLfloat>(engine->world->tickCycle))
-            )
-        );
         this->shader->bindCubemap(*this->negativeSky);
         glBindVertexArray(this->vao);
         glDrawArrays(GL_TRIANGLES, 0, 36);
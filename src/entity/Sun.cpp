@@ -1,4 +1,4 @@
-#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
 #include <entity/Sun.hpp>
 #include <app/Engine.hpp>
@@ -8,10 +8,24 @@
 namespace entity {
     
     Sun::Sun() :
-        shader(std::make_unique<shader::Shader>("../shader/sun.vs.glsl", "../shader/sun.fs.glsl")) {
-        this->shader->addUniform("uMVP", shader::UNIFORM_MATRIX_4F);
+        shader(std::make_unique<shader::Shader>("../shader/sun.vs.glsl", "../shader/sun.fs.glsl")),
+        uModel(*this->shader, "uModel") {
         glGenBuffers(1, &this->vbo);
         glGenVertexArrays(1, &this->vao);
+        
+        // The cube never changes, it is moved around the camera by the model matrix
+        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(this->vertices), this->vertices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        
+        glBindVertexArray(this->vao);
+        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+        glEnableVertexAttribArray(VERTEX_ATTR_POSITION);
+        glVertexAttribPointer(
+            VERTEX_ATTR_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
     }
     
     
@@ -26,7 +40,7 @@ namespace entity {
         app::Config *config = app::Config::getInstance();
         
         GLfloat angle = (
-            360.f / config->getTickPerDay() * static_cast<float>(engine->world->tickCycle)
+            360.f / config->getTickPerDay() * engine->world->renderTickCycle
         );
         glm::mat4 rotationZ = glm::rotate(
             glm::mat4(1.f), glm::radians(angle), glm::vec3(0.f, 0.f, 1.f)
@@ -34,45 +48,20 @@ namespace entity {
         glm::mat4 rotationY = glm::rotate(
             glm::mat4(1.f), glm::radians(45.f), glm::vec3(0.f, 1.f, 0.f)
         );
-        glm::vec3 position, camera = engine->camera->getPosition();
-        glm::vec3 vertices[36];
         
         this->position = glm::vec3(rotationY * rotationZ * glm::vec4(1000, 0, 0, 1));
-        
-        for (GLuint i = 0; i < 36; i++) {
-            position = glm::vec3(
-                rotationY * rotationZ * glm::vec4(this->vertices[i] + glm::vec3(20, 0, 0), 1)
-            );
-            position += camera;
-            vertices[i] = position;
-        }
-        
-        // Fill the VBO
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        
-        // Set the VAO
-        glBindVertexArray(this->vao);
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glEnableVertexAttribArray(VERTEX_ATTR_POSITION);
-        glVertexAttribPointer(
-            VERTEX_ATTR_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr
+        this->model = (
+            glm::translate(glm::mat4(1.f), engine->camera->getRenderPosition())
+            * rotationY * rotationZ * glm::translate(glm::mat4(1.f), glm::vec3(20, 0, 0))
         );
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
         
         return 1;
     }
     
     
     GLuint Sun::render() {
-        app::Engine *engine = app::Engine::getInstance();
-        glm::mat4 MVMatrix = engine->camera->getViewMatrix();
-        glm::mat4 MVPMatrix = engine->camera->getProjMatrix() * MVMatrix;
-        
         this->shader->use();
-        this->shader->loadUniform("uMVP", glm::value_ptr(MVPMatrix));
+        this->uModel.load(this->model);
         glBindVertexArray(this->vao);
         glDrawArrays(GL_TRIANGLES, 0, 36);
         glBindVertexArray(0);
@@ -1,25 +1,116 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <effolkronium/random.hpp>
+
 #include <app/Engine.hpp>
+#include <app/Benchmark.hpp>
+#include <shader/Shader.hpp>
 
 
 using namespace app;
+using Random = effolkronium::random_static;
+
+
+static void usage(const char *name) {
+    std::cerr << "Usage: " << name << " [OPTIONS]\n\n"
+              << "Options:\n"
+              << "  --no-shader-cache   Always compile shaders from source.\n"
+              << "  --no-interpolation  Render the state of the last tick instead of interpolating between ticks.\n"
+              << "  --benchmark PATH    Run a benchmark along PATH, either 'straight', 'spiral', 'teleport'\n"
+              << "                      or a file of keyframes recorded with F3.\n"
+              << "  --seed N            Seed of the world (default: 0 with --benchmark, random otherwise).\n"
+              << "  --distance N        Distance view, in SuperChunks (default: 2).\n"
+              << "  --ticks N           Duration of the benchmark in ticks (default: 1800).\n"
+              << "  --hitch MS          Frame time counted as a hitch (default: 33.3).\n"
+              << "  --output FILE       Also write the benchmark's JSON report to FILE.\n"
+              << "  --headless WxH      Render offscreen at the given size, without display (e.g. 1280x720).\n"
+              << "  --capture FILE      With --headless, save the last frame as a PNG to FILE.\n";
+}
 
 
 int main(int argc, char **argv) {
     Engine *engine = Engine::getInstance();
+    Config *config = Config::getInstance();
+    std::string benchmark, output, capture, option;
+    GLint width = 0, height = 0;
+    GLuint seed = 0, ticks = 1800;
+    GLboolean seeded = false;
+    GLint distance = config->getDistanceView();
+    GLdouble hitch = 1000. / 30.;
+    
+    try {
+        for (int i = 1; i < argc; i++) {
+            option = argv[i];
+            if (option == "--no-shader-cache") {
+                shader::Shader::setBinaryCache(false);
+                continue;
+            }
+            if (option == "--no-interpolation") {
+                config->setInterpolation(false);
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(option);
+            }
+            if (option == "--benchmark") {
+                benchmark = argv[++i];
+            }
+            else if (option == "--seed") {
+                seed = static_cast<GLuint>(std::stoul(argv[++i]));
+                seeded = true;
+            }
+            else if (option == "--distance") {
+                distance = std::stoi(argv[++i]);
+            }
+            else if (option == "--ticks") {
+                ticks = static_cast<GLuint>(std::stoul(argv[++i]));
+            }
+            else if (option == "--hitch") {
+                hitch = std::stod(argv[++i]);
+            }
+            else if (option == "--output") {
+                output = argv[++i];
+            }
+            else if (option == "--headless") {
+                if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+                    throw std::invalid_argument(option);
+                }
+            }
+            else if (option == "--capture") {
+                capture = argv[++i];
+            }
+            else {
+                throw std::invalid_argument(option);
+            }
+        }
+    } catch (const std::logic_error &) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    // The seed must be set before the world draws its noise offsets
+    if (seeded || !benchmark.empty()) {
+        Random::seed(seed);
+    }
+    config->setDistanceView(distance);
+    if (width > 0) {
+        engine->setHeadless(width, height, capture);
+    }
+    if (!benchmark.empty()) {
+        engine->benchmark = std::make_unique<Benchmark>(benchmark, seed, distance, ticks, hitch, output);
+    }
     
     engine->init();
     
+    // The simulation runs on its own thread, this one only renders
     while (engine->isRunning()) {
-        
-        if (engine->tick()) {
-            engine->update();
-        }
-        
         engine->render();
+        engine->wait();
     }
     
     engine->cleanup();
     
     return EXIT_SUCCESS;
 }
-
@@ -0,0 +1,81 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <misc/AssetLoader.hpp>
+#include <misc/Hash.hpp>
+
+
+namespace misc {
+    
+    AssetLoader *AssetLoader::getInstance() {
+        static AssetLoader loader;
+        return &loader;
+    }
+    
+    
+    Image *AssetLoader::loadImage(const std::string &path) const {
+        std::ifstream file = std::ifstream(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Error: Could not open image '" + path + "'");
+        }
+        std::vector<GLubyte> encoded = std::vector<GLubyte>(
+            std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()
+        );
+        GLuint64 key = Hash::fnv1a(encoded.data(), encoded.size());
+        
+        std::unique_ptr<MappedFile> mapping = this->cache.map(key);
+        if (mapping && mapping->getSize() >= sizeof(CacheHeader)) {
+            CacheHeader header {};
+            std::memcpy(&header, mapping->getData(), sizeof(CacheHeader));
+            
+            GLuint64 expected = sizeof(CacheHeader)
+                                + static_cast<GLuint64>(header.width) * header.height * Image::CHANNELS;
+            if (!std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC))
+                && header.version == CACHE_VERSION && mapping->getSize() == expected) {
+                return new Image(header.width, header.height, std::move(mapping), sizeof(CacheHeader));
+            }
+        }
+        
+        Image *image = Image::loadPNG(encoded, path);
+        CacheHeader header {};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.width = image->getWidth();
+        header.height = image->getHeight();
+        this->cache.write(
+            key, &header, sizeof(CacheHeader), image->getPixels(),
+            static_cast<GLuint64>(header.width) * header.height * Image::CHANNELS
+        );
+        
+        return image;
+    }
+    
+    
+    std::future<std::unique_ptr<Image>> AssetLoader::loadImageAsync(const std::string &path) const {
+        return std::async(std::launch::async, [this, path]() {
+            return std::unique_ptr<Image>(this->loadImage(path));
+        });
+    }
+    
+    
+    std::vector<std::unique_ptr<Image>> AssetLoader::loadImages(
+        const std::vector<std::string> &paths
+    ) const {
+        std::vector<std::future<std::unique_ptr<Image>>> futures;
+        std::vector<std::unique_ptr<Image>> images;
+        
+        futures.reserve(paths.size());
+        for (const std::string &path : paths) {
+            futures.push_back(this->loadImageAsync(path));
+        }
+        
+        images.reserve(paths.size());
+        for (std::future<std::unique_ptr<Image>> &future : futures) {
+            images.push_back(future.get());
+        }
+        
+        return images;
+    }
+}
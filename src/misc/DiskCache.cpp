@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <thread>
+#include <functional>
+
+#include <misc/DiskCache.hpp>
+#include <misc/Hash.hpp>
+
+
+namespace misc {
+    
+    DiskCache::DiskCache(const std::string &t_directory, const std::string &t_extension) :
+        directory(t_directory), extension(t_extension) {
+    }
+    
+    
+    std::string DiskCache::getPath(GLuint64 key) const {
+        return this->directory + "/" + Hash::toHex(key) + this->extension;
+    }
+    
+    
+    std::unique_ptr<MappedFile> DiskCache::map(GLuint64 key) const {
+        std::string path = this->getPath(key);
+        std::error_code error;
+        
+        if (!std::filesystem::is_regular_file(path, error)) {
+            return nullptr;
+        }
+        
+        try {
+            return std::make_unique<MappedFile>(path);
+        } catch (const std::runtime_error &e) {
+            std::cerr << "Warning: Ignoring cache entry: " << e.what() << std::endl;
+            return nullptr;
+        }
+    }
+    
+    
+    bool DiskCache::write(GLuint64 key, const void *header, std::size_t headerSize,
+                          const void *payload, std::size_t payloadSize) const {
+        std::string path = this->getPath(key);
+        std::string tmp = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+                          + ".tmp";
+        std::error_code error;
+        
+        std::filesystem::create_directories(this->directory, error);
+        if (error) {
+            std::cerr << "Warning: Unable to create cache directory '" << this->directory << "': "
+                      << error.message() << std::endl;
+            return false;
+        }
+        
+        std::ofstream output = std::ofstream(tmp, std::ios::binary | std::ios::trunc);
+        output.write(static_cast<const char *>(header), static_cast<std::streamsize>(headerSize));
+        output.write(static_cast<const char *>(payload), static_cast<std::streamsize>(payloadSize));
+        output.close();
+        
+        if (!output) {
+            std::cerr << "Warning: Unable to write cache entry '" << tmp << "'" << std::endl;
+            std::remove(tmp.c_str());
+            return false;
+        }
+        
+        std::filesystem::rename(tmp, path, error);
+        if (error) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        
+        return true;
+    }
+}
@@ -0,0 +1,31 @@
+#include <iomanip>
+#include <sstream>
+
+#include <misc/Hash.hpp>
+
+
+namespace misc {
+    
+    GLuint64 Hash::fnv1a(const void *data, std::size_t size, GLuint64 hash) {
+        const auto *bytes = static_cast<const GLubyte *>(data);
+        
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= PRIME;
+        }
+        
+        return hash;
+    }
+    
+    
+    GLuint64 Hash::fnv1a(const std::string &data, GLuint64 hash) {
+        return fnv1a(data.data(), data.size(), hash);
+    }
+    
+    
+    std::string Hash::toHex(GLuint64 hash) {
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return ss.str();
+    }
+}
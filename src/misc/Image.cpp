@@ -1,20 +1,29 @@
+#include <cstring>
+#include <stdexcept>
+
 #include <lodepng/lodepng.hpp>
 
 #include <misc/Image.hpp>
-#include <iostream>
 
 
 namespace misc {
     
-    Image::Image(unsigned int t_width, unsigned int t_height, std::vector<glm::vec4> t_pixels) :
-            width(t_width), height(t_height), pixels(std::move(t_pixels)) {
+    Image::Image(unsigned int t_width, unsigned int t_height, std::vector<GLubyte> t_pixels) :
+            width(t_width), height(t_height), pixels(std::move(t_pixels)), data(pixels.data()) {
+    }
+    
+    
+    Image::Image(GLuint t_width, GLuint t_height, std::unique_ptr<MappedFile> t_mapping,
+                 std::size_t offset) :
+            width(t_width), height(t_height), mapping(std::move(t_mapping)) {
+        if (offset + static_cast<GLuint64>(t_width) * t_height * CHANNELS > this->mapping->getSize()) {
+            throw std::runtime_error("Error: Mapped image is smaller than its dimension.");
+        }
+        this->data = static_cast<GLubyte *>(this->mapping->getData()) + offset;
     }
     
     
     Image *Image::loadPNG(const std::string &path) {
-        static constexpr float SCALE = 1.f / 255.f;
-        
-        std::vector<glm::vec4> pixels;
         std::vector<GLubyte> raw;
         GLuint width, height;
         
@@ -24,12 +33,68 @@ namespace misc {
             throw std::runtime_error(msg);
         }
         
-        pixels.resize(raw.size() / 4);
-        for (GLuint64 i = 0; i < pixels.size(); i++) {
-            pixels[i] = { raw[i * 4] * SCALE, raw[i * 4 + 1] * SCALE, raw[i * 4 + 2] * SCALE, raw[i * 4 + 3] * SCALE };
+        return new Image(width, height, std::move(raw));
+    }
+    
+    
+    Image *Image::loadPNG(const std::vector<GLubyte> &encoded, const std::string &path) {
+        std::vector<GLubyte> raw;
+        GLuint width, height;
+        
+        GLuint error = lodepng::decode(raw, width, height, encoded);
+        if (error) {
+            std::string msg = "Error: Could not load image '" + path + "': " + lodepng_error_text(error);
+            throw std::runtime_error(msg);
+        }
+        
+        return new Image(width, height, std::move(raw));
+    }
+    
+    
+    void Image::savePNG(const std::string &path) const {
+        GLuint error = lodepng::encode(path, this->data, this->width, this->height);
+        if (error) {
+            std::string msg = "Error: Could not save image '" + path + "': " + lodepng_error_text(error);
+            throw std::runtime_error(msg);
+        }
+    }
+    
+    
+    Image *Image::crop(GLuint x, GLuint y, GLuint t_width, GLuint t_height) const {
+        if (x + t_width > this->width || y + t_height > this->height) {
+            throw std::runtime_error("Error: Cropping area is outside of the image.");
+        }
+        
+        std::vector<GLubyte> cropped(static_cast<GLuint64>(t_width) * t_height * CHANNELS);
+        for (GLuint row = 0; row < t_height; row++) {
+            std::memcpy(
+                    cropped.data() + static_cast<GLuint64>(row) * t_width * CHANNELS,
+                    this->data + (static_cast<GLuint64>(y + row) * this->width + x) * CHANNELS,
+                    static_cast<GLuint64>(t_width) * CHANNELS
+            );
+        }
+        
+        return new Image(t_width, t_height, std::move(cropped));
+    }
+    
+    
+    Image *Image::resize(GLuint t_width, GLuint t_height) const {
+        std::vector<GLubyte> resized(static_cast<GLuint64>(t_width) * t_height * CHANNELS);
+        GLuint64 srcX, srcY;
+        
+        for (GLuint row = 0; row < t_height; row++) {
+            srcY = static_cast<GLuint64>(row) * this->height / t_height;
+            for (GLuint col = 0; col < t_width; col++) {
+                srcX = static_cast<GLuint64>(col) * this->width / t_width;
+                std::memcpy(
+                        resized.data() + (static_cast<GLuint64>(row) * t_width + col) * CHANNELS,
+                        this->data + (srcY * this->width + srcX) * CHANNELS,
+                        CHANNELS
+                );
+            }
         }
         
-        return new Image(width, height, pixels);
+        return new Image(t_width, t_height, std::move(resized));
     }
     
     
@@ -43,12 +108,12 @@ namespace misc {
     }
     
     
-    const glm::vec4 *Image::getPixels() const {
-        return pixels.data();
+    const GLubyte *Image::getPixels() const {
+        return data;
     }
     
     
-    glm::vec4 *Image::getPixels() {
-        return pixels.data();
+    GLubyte *Image::getPixels() {
+        return data;
     }
 }
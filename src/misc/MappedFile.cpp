@@ -0,0 +1,58 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <misc/MappedFile.hpp>
+
+
+namespace misc {
+    
+    MappedFile::MappedFile(const std::string &path) {
+        struct stat st {};
+        int fd = open(path.c_str(), O_RDONLY);
+        
+        if (fd < 0) {
+            throw std::runtime_error("Error: Unable to open the file '" + path + "'");
+        }
+        if (fstat(fd, &st) < 0) {
+            std::string error = std::strerror(errno);
+            close(fd);
+            throw std::runtime_error("Error: Unable to read the size of the file '" + path + "': " + error);
+        }
+        if (st.st_size <= 0) {
+            close(fd);
+            throw std::runtime_error("Error: Unable to map the empty file '" + path + "'");
+        }
+        
+        this->size = static_cast<std::size_t>(st.st_size);
+        this->data = mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        
+        if (this->data == MAP_FAILED) {
+            this->data = nullptr;
+            throw std::runtime_error("Error: Unable to map the file '" + path + "'");
+        }
+    }
+    
+    
+    MappedFile::~MappedFile() {
+        if (this->data) {
+            munmap(this->data, this->size);
+        }
+    }
+    
+    
+    void *MappedFile::getData() const {
+        return this->data;
+    }
+    
+    
+    std::size_t MappedFile::getSize() const {
+        return this->size;
+    }
+}
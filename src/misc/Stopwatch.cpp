@@ -0,0 +1,36 @@
+#include <iomanip>
+#include <iostream>
+
+#include <misc/Stopwatch.hpp>
+
+
+namespace misc {
+    
+    Stopwatch::Stopwatch(const std::string &t_name) :
+        name(t_name), start(std::chrono::steady_clock::now()), last(start) {
+    }
+    
+    
+    GLdouble Stopwatch::lap(const std::string &phase) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        GLdouble ms = std::chrono::duration<GLdouble, std::milli>(now - this->last).count();
+        
+        this->last = now;
+        std::cout << "[" << this->name << "] " << std::left << std::setw(24) << phase << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(9) << ms << " ms" << std::endl;
+        
+        return ms;
+    }
+    
+    
+    GLdouble Stopwatch::total() {
+        GLdouble ms = std::chrono::duration<GLdouble, std::milli>(
+            std::chrono::steady_clock::now() - this->start
+        ).count();
+        
+        std::cout << "[" << this->name << "] " << std::left << std::setw(24) << "total" << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(9) << ms << " ms" << std::endl;
+        
+        return ms;
+    }
+}
@@ -0,0 +1,127 @@
+#include <array>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <misc/Trace.hpp>
+
+
+namespace misc {
+    
+    struct TraceBuffer {
+        std::array<Trace::Event, Trace::CAPACITY> events {};
+        std::atomic<GLuint64> head { 0 }; /**< Total number of events ever written. */
+        GLuint tid = 0;
+    };
+    
+    
+    
+    struct TraceRegistry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    };
+    
+    
+    static TraceRegistry &getRegistry() {
+        static TraceRegistry registry;
+        return registry;
+    }
+    
+    
+    /**
+     * Buffer of the calling thread, registered on first use. Buffers are kept alive by the
+     * registry after their thread exits so they can still be dumped.
+     */
+    static TraceBuffer &getTraceBuffer() {
+        thread_local std::shared_ptr<TraceBuffer> buffer = []() {
+            TraceRegistry &registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            
+            auto created = std::make_shared<TraceBuffer>();
+            created->tid = static_cast<GLuint>(registry.buffers.size()) + 1;
+            registry.buffers.push_back(created);
+            return created;
+        }();
+        
+        return *buffer;
+    }
+    
+    
+    GLint64 Trace::now() {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - epoch
+        ).count();
+    }
+    
+    
+    void Trace::record(const Event &event) {
+        TraceBuffer &buffer = getTraceBuffer();
+        GLuint64 head = buffer.head.load(std::memory_order_relaxed);
+        
+        buffer.events[head % CAPACITY] = event;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+    
+    
+    GLuint64 Trace::dump(const std::string &path) {
+        TraceRegistry &registry = getRegistry();
+        std::vector<std::shared_ptr<TraceBuffer>> buffers;
+        std::ofstream output = std::ofstream(path, std::ios::trunc);
+        GLuint64 written = 0;
+        GLuint64 head, first;
+        
+        if (!output) {
+            throw std::runtime_error("Error: Could not open '" + path + "' to write the trace.");
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            buffers = registry.buffers;
+        }
+        
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (const std::shared_ptr<TraceBuffer> &buffer : buffers) {
+            output << (written ? ",\n" : "\n")
+                   << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->tid
+                   << R"(,"args":{"name":"thread )" << buffer->tid << "\"}}";
+            written++;
+            
+            head = buffer->head.load(std::memory_order_acquire);
+            first = head > CAPACITY ? head - CAPACITY : 0;
+            for (GLuint64 i = first; i < head; i++) {
+                const Event &event = buffer->events[i % CAPACITY];
+                output << ",\n{\"name\":\"" << event.name << R"(","ph":"X","pid":1,"tid":)" << buffer->tid
+                       << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+                if (event.hasPosition) {
+                    output << ",\"args\":{\"x\":" << event.position.x << ",\"y\":" << event.position.y
+                           << ",\"z\":" << event.position.z << "}";
+                }
+                output << "}";
+                written++;
+            }
+        }
+        output << "\n]}\n";
+        
+        return written;
+    }
+    
+    
+    TraceScope::TraceScope(const char *name) :
+        event({ name, Trace::now(), 0, glm::ivec3(0), false }) {
+    }
+    
+    
+    TraceScope::TraceScope(const char *name, const glm::ivec3 &position) :
+        event({ name, Trace::now(), 0, position, true }) {
+    }
+    
+    
+    TraceScope::~TraceScope() {
+        this->event.duration = Trace::now() - this->event.start;
+        Trace::record(this->event);
+    }
+}
@@ -1,17 +1,19 @@
 #include <shader/Cubemap.hpp>
+#include <misc/Trace.hpp>
 
 
 namespace shader {
     
     Cubemap::Cubemap(std::unique_ptr<misc::Image> texture[6]) {
+        TRACE_SCOPE("Cubemap::upload");
         glGenTextures(1, &this->textureId);
         
         glBindTexture(GL_TEXTURE_CUBE_MAP, this->textureId);
         
         for (GLuint i = 0; i < 6; i++) {
             glTexImage2D(
-                    GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, static_cast<GLsizei>(texture[i]->getWidth()),
-                    static_cast<GLsizei>(texture[i]->getHeight()), 0, GL_RGBA, GL_FLOAT, texture[i]->getPixels()
+                    GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, static_cast<GLsizei>(texture[i]->getWidth()),
+                    static_cast<GLsizei>(texture[i]->getHeight()), 0, GL_RGBA, GL_UNSIGNED_BYTE, texture[i]->getPixels()
             );
         }
         
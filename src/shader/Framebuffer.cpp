@@ -0,0 +1,100 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <shader/Framebuffer.hpp>
+
+
+namespace shader {
+    
+    Framebuffer::Framebuffer(GLsizei t_width, GLsizei t_height) :
+        width(t_width), height(t_height) {
+        GLenum status;
+        
+        glGenRenderbuffers(1, &this->color);
+        glBindRenderbuffer(GL_RENDERBUFFER, this->color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, t_width, t_height);
+        glGenRenderbuffers(1, &this->depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, this->depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, t_width, t_height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        
+        glGenFramebuffers(1, &this->fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, this->fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->color);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->depth);
+        status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            throw std::runtime_error("Error: Framebuffer is incomplete (status " + std::to_string(status) + ")");
+        }
+    }
+    
+    
+    Framebuffer::~Framebuffer() {
+        glDeleteFramebuffers(1, &this->fbo);
+        glDeleteRenderbuffers(1, &this->color);
+        glDeleteRenderbuffers(1, &this->depth);
+    }
+    
+    
+    void Framebuffer::bind() const {
+        glBindFramebuffer(GL_FRAMEBUFFER, this->fbo);
+        glViewport(0, 0, this->width, this->height);
+    }
+    
+    
+    void Framebuffer::unbind() const {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    
+    
+    void Framebuffer::blit(const Framebuffer *target, GLsizei t_width, GLsizei t_height) const {
+        GLuint targetFbo = target ? target->fbo : 0;
+        
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFbo);
+        glBlitFramebuffer(
+            0, 0, this->width, this->height, 0, 0, t_width, t_height, GL_COLOR_BUFFER_BIT, GL_LINEAR
+        );
+        glBindFramebuffer(GL_FRAMEBUFFER, targetFbo);
+        glViewport(0, 0, t_width, t_height);
+    }
+    
+    
+    misc::Image *Framebuffer::read() const {
+        GLuint64 rowSize = static_cast<GLuint64>(this->width) * misc::Image::CHANNELS;
+        std::vector<GLubyte> pixels = std::vector<GLubyte>(rowSize * static_cast<GLuint64>(this->height));
+        std::vector<GLubyte> row = std::vector<GLubyte>(rowSize);
+        
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->fbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, this->width, this->height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        
+        // OpenGL returns the bottom row first
+        for (GLsizei y = 0; y < this->height / 2; y++) {
+            GLubyte *top = pixels.data() + static_cast<GLuint64>(y) * rowSize;
+            GLubyte *bottom = pixels.data() + static_cast<GLuint64>(this->height - 1 - y) * rowSize;
+            std::memcpy(row.data(), top, rowSize);
+            std::memcpy(top, bottom, rowSize);
+            std::memcpy(bottom, row.data(), rowSize);
+        }
+        
+        return new misc::Image(
+            static_cast<GLuint>(this->width), static_cast<GLuint>(this->height), std::move(pixels)
+        );
+    }
+    
+    
+    GLsizei Framebuffer::getWidth() const {
+        return this->width;
+    }
+    
+    
+    GLsizei Framebuffer::getHeight() const {
+        return this->height;
+    }
+}
@@ -1,13 +1,61 @@
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include <shader/Shader.hpp>
+#include <shader/FrameUniforms.hpp>
 #include <shader/uniform/uniform_all.hpp>
 #include <misc/FileReader.hpp>
+#include <misc/DiskCache.hpp>
+#include <misc/Hash.hpp>
 
 
 namespace shader {
     
+    GLboolean Shader::binaryCache = true;
+    
+    
+    static const misc::DiskCache &getProgramCache() {
+        static const misc::DiskCache cache = misc::DiskCache("../cache/shader", ".bin");
+        return cache;
+    }
+    
+    
+    /**
+     * Whether programs can be retrieved and loaded as binaries, decided once for the context.
+     * Without it, the functions of `ARB_get_program_binary` are not loaded by GLEW.
+     */
+    static bool isBinarySupported() {
+        static const bool supported = []() {
+            GLint formats = 0;
+            
+            if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) {
+                return false;
+            }
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            return formats > 0;
+        }();
+        
+        return supported;
+    }
+    
+    
+    /**
+     * Key of a program in the cache, a binary is only valid for the same sources, GPU and driver.
+     */
+    static GLuint64 getProgramKey(const std::string &vsSource, const std::string &fsSource) {
+        static const std::string renderer = std::string(reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+        static const std::string version = std::string(reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+        
+        GLuint64 key = misc::Hash::fnv1a(renderer);
+        key = misc::Hash::fnv1a(version, key);
+        key = misc::Hash::fnv1a(vsSource, key);
+        // Separate the sources so that moving code from one stage to the other changes the key
+        key = misc::Hash::fnv1a("\0", 1, key);
+        return misc::Hash::fnv1a(fsSource, key);
+    }
+    
+    
     static std::string getHeader(const std::string &driver) {
         std::string header;
         
@@ -18,19 +66,46 @@ namespace shader {
             header = "#version 300 es\n\nprecision mediump float;";
         }
         else {
-            throw std::runtime_error("Error : Unknown driver : " + driver);
+            std::cerr << "Warning: Unknown driver '" << driver << "', assuming GLSL 3.30 core" << std::endl;
+            header = "#version 330 core";
         }
         
         return header;
     }
     
     
-    static std::string addVersion(const std::string &shaderSrc) {
+    /**
+     * Replace the `#{{ HEADER }}` line of a source by the version directive, followed by a
+     * `#define` for each of the given names.
+     */
+    static std::string addVersion(const std::string &shaderSrc, const std::vector<std::string> &defines) {
         static const std::string driver = std::string(reinterpret_cast<const char *>(glGetString(GL_VERSION)));
         static const std::string header = getHeader(driver);
         
+        std::string fullHeader = header + "\n";
+        for (const std::string &define : defines) {
+            fullHeader += "\n#define " + define;
+        }
+        
         std::string newSrc = shaderSrc;
-        newSrc = newSrc.replace(0, 13, header);
+        newSrc = newSrc.replace(0, 13, fullHeader);
+        
+        return newSrc;
+    }
+    
+    
+    /**
+     * Replace the `#{{ FRAME }}` line of a source by the declaration of the `Frame` uniform block.
+     */
+    static std::string addFrameBlock(const std::string &shaderSrc) {
+        static const std::string token = "#{{ FRAME }}";
+        static const std::string block = misc::FileReader::read(FrameUniforms::SOURCE);
+        
+        std::string newSrc = shaderSrc;
+        std::string::size_type position = newSrc.find(token);
+        if (position != std::string::npos) {
+            newSrc = newSrc.replace(position, token.size(), block);
+        }
         
         return newSrc;
     }
@@ -68,15 +143,27 @@ namespace shader {
     }
     
     
-    Shader::Shader(const std::string &vsPath, const std::string &fsPath) :
+    Shader::Shader(const std::string &vsPath, const std::string &fsPath, const std::vector<std::string> &defines) :
             programId(glCreateProgram()), vsId(glCreateShader(GL_VERTEX_SHADER)),
             fsId(glCreateShader(GL_FRAGMENT_SHADER)) {
-        const std::string vsSource = addVersion(misc::FileReader::read(vsPath));
-        const std::string fsSource = addVersion(misc::FileReader::read(fsPath));
+        const std::string vsSource = addFrameBlock(addVersion(misc::FileReader::read(vsPath), defines));
+        const std::string fsSource = addFrameBlock(addVersion(misc::FileReader::read(fsPath), defines));
         const char *cVsSource = vsSource.c_str();
         const char *cFsSource = fsSource.c_str();
+        GLuint64 key = 0;
         GLint status;
         
+        if (binaryCache && !isBinarySupported()) {
+            binaryCache = false;
+        }
+        if (binaryCache) {
+            key = getProgramKey(vsSource, fsSource);
+            if (this->loadBinary(key)) {
+                this->bindFrameBlock();
+                return;
+            }
+        }
+        
         glShaderSource(this->vsId, 1, &cVsSource, nullptr);
         glShaderSource(this->fsId, 1, &cFsSource, nullptr);
         
@@ -98,6 +185,9 @@ namespace shader {
         glAttachShader(this->programId, this->vsId);
         glAttachShader(this->programId, this->fsId);
         
+        if (binaryCache) {
+            glProgramParameteri(this->programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
         glLinkProgram(this->programId);
         glGetProgramiv(this->programId, GL_LINK_STATUS, &status);
         if (status != GL_TRUE) {
@@ -105,6 +195,74 @@ namespace shader {
                     "Failed to link shaders'" + vsPath + "' and '" + fsPath + "': " + getProgramInfoLog(this->programId)
             );
         }
+        
+        this->bindFrameBlock();
+        
+        if (binaryCache) {
+            this->storeBinary(key);
+        }
+    }
+    
+    
+    GLboolean Shader::loadBinary(GLuint64 key) {
+        GLint status;
+        CacheHeader header {};
+        
+        std::unique_ptr<misc::MappedFile> mapping = getProgramCache().map(key);
+        if (!mapping || mapping->getSize() < sizeof(CacheHeader)) {
+            return false;
+        }
+        
+        std::memcpy(&header, mapping->getData(), sizeof(CacheHeader));
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) || header.version != CACHE_VERSION
+            || mapping->getSize() != sizeof(CacheHeader) + header.length) {
+            return false;
+        }
+        
+        // The driver may reject a binary even for the same renderer string (e.g. after an update),
+        // the program is then left unlinked and is built from the sources.
+        glProgramBinary(
+            this->programId, header.format, static_cast<GLubyte *>(mapping->getData()) + sizeof(CacheHeader),
+            static_cast<GLsizei>(header.length)
+        );
+        glGetProgramiv(this->programId, GL_LINK_STATUS, &status);
+        
+        return status == GL_TRUE;
+    }
+    
+    
+    void Shader::storeBinary(GLuint64 key) const {
+        GLint length = 0;
+        CacheHeader header {};
+        
+        glGetProgramiv(this->programId, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+        
+        std::vector<GLubyte> binary = std::vector<GLubyte>(static_cast<GLuint64>(length));
+        glGetProgramBinary(this->programId, length, &length, &header.format, binary.data());
+        
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.length = static_cast<GLuint>(length);
+        getProgramCache().write(key, &header, sizeof(CacheHeader), binary.data(), header.length);
+    }
+    
+    
+    void Shader::bindFrameBlock() const {
+        GLuint index = glGetUniformBlockIndex(this->programId, FrameUniforms::BLOCK);
+        
+        // Programs that do not declare the block (or whose block is unused) keep index
+        // GL_INVALID_INDEX
+        if (index != GL_INVALID_INDEX) {
+            glUniformBlockBinding(this->programId, index, FrameUniforms::BINDING);
+        }
+    }
+    
+    
+    void Shader::setBinaryCache(GLboolean enabled) {
+        binaryCache = enabled;
     }
     
     
@@ -195,6 +353,18 @@ namespace shader {
     }
     
     
+    GLint Shader::getUniformLocation(const GLchar *name) const {
+        GLint location = glGetUniformLocation(this->programId, name);
+        
+        if (location == -1) {
+            std::cerr << "Warning: '" << name << "' does not correspond to an active uniform variable in program '"
+                      << this->programId << "'." << std::endl;
+        }
+        
+        return location;
+    }
+    
+    
     void Shader::use() const {
         glUseProgram(this->programId);
     }
@@ -3,8 +3,9 @@
 
 namespace shader {
     
-    ShaderTexture::ShaderTexture(const std::string &vsFile, const std::string &fsFile) :
-            Shader(vsFile, fsFile) {
+    ShaderTexture::ShaderTexture(const std::string &vsFile, const std::string &fsFile,
+                                 const std::vector<std::string> &defines) :
+            Shader(vsFile, fsFile, defines) {
         this->uTexture = glGetUniformLocation(this->programId, "uTexture");
     }
     
@@ -15,7 +16,14 @@ namespace shader {
     }
     
     
+    void ShaderTexture::bindTexture(const TextureArray &texture) const {
+        glUniform1i(this->uTexture, 0);
+        texture.bind();
+    }
+    
+    
     void ShaderTexture::unbindTexture() const {
         glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     }
 }
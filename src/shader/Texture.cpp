@@ -8,8 +8,8 @@ namespace shader {
         
         glBindTexture(GL_TEXTURE_2D, this->textureId);
         glTexImage2D(
-                GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(texture->getWidth()),
-                static_cast<GLsizei>(texture->getHeight()), 0, GL_RGBA, GL_FLOAT, texture->getPixels()
+                GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>(texture->getWidth()),
+                static_cast<GLsizei>(texture->getHeight()), 0, GL_RGBA, GL_UNSIGNED_BYTE, texture->getPixels()
         );
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -0,0 +1,74 @@
+#include <stdexcept>
+
+#include <shader/TextureArray.hpp>
+#include <misc/Trace.hpp>
+
+
+namespace shader {
+    
+    TextureArray::TextureArray(const std::vector<std::unique_ptr<misc::Image>> &t_layers) :
+            layers(static_cast<GLuint>(t_layers.size())) {
+        TRACE_SCOPE("TextureArray::upload");
+        GLint maxLayers;
+        
+        if (t_layers.empty()) {
+            throw std::runtime_error("Error: Cannot create a texture array without any layer.");
+        }
+        
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+        if (this->layers > static_cast<GLuint>(maxLayers)) {
+            throw std::runtime_error(
+                    "Error: Texture array needs " + std::to_string(this->layers) + " layers, but driver only supports "
+                    + std::to_string(maxLayers) + "."
+            );
+        }
+        
+        GLsizei width = static_cast<GLsizei>(t_layers[0]->getWidth());
+        GLsizei height = static_cast<GLsizei>(t_layers[0]->getHeight());
+        
+        glGenTextures(1, &this->textureId);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, this->textureId);
+        glTexImage3D(
+                GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, static_cast<GLsizei>(this->layers), 0, GL_RGBA,
+                GL_UNSIGNED_BYTE, nullptr
+        );
+        
+        for (GLuint i = 0; i < this->layers; i++) {
+            if (static_cast<GLsizei>(t_layers[i]->getWidth()) != width
+                || static_cast<GLsizei>(t_layers[i]->getHeight()) != height) {
+                throw std::runtime_error("Error: Every layer of a texture array must have the same dimension.");
+            }
+            glTexSubImage3D(
+                    GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i), width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                    t_layers[i]->getPixels()
+            );
+        }
+        
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+    
+    
+    TextureArray::~TextureArray() {
+        glDeleteTextures(1, &this->textureId);
+    }
+    
+    
+    void TextureArray::bind() const {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, this->textureId);
+    }
+    
+    
+    void TextureArray::unbind() const {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+    
+    
+    GLuint TextureArray::getLayerCount() const {
+        return this->layers;
+    }
+}
@@ -0,0 +1,26 @@
+#include <shader/UniformBuffer.hpp>
+
+
+namespace shader {
+    
+    UniformBuffer::UniformBuffer(GLuint binding, GLsizeiptr t_size) :
+        size(t_size) {
+        glGenBuffers(1, &this->ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER, this->ubo);
+        glBufferData(GL_UNIFORM_BUFFER, t_size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, this->ubo);
+    }
+    
+    
+    UniformBuffer::~UniformBuffer() {
+        glDeleteBuffers(1, &this->ubo);
+    }
+    
+    
+    void UniformBuffer::update(const void *data) const {
+        glBindBuffer(GL_UNIFORM_BUFFER, this->ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, this->size, data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+}
@@ -1,3 +1,4 @@
+#include <glm/common.hpp>
 #include <glm/trigonometric.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -17,18 +18,24 @@ namespace tool {
     Camera::Camera() :
         position(glm::vec3(0, 0, 0)), pitch(0.0), yaw(M_PIf32) {
         computeDirectionVectors();
+        snap();
     }
     
     
-    void Camera::computeDirectionVectors() {
-        this->frontVector = {
-            std::cos(this->pitch) * std::sin(this->yaw),
-            std::sin(this->pitch),
-            std::cos(this->pitch) * std::cos(this->yaw)
+    void Camera::computeDirectionVectors(GLfloat pitch, GLfloat yaw, glm::vec3 &front, glm::vec3 &left,
+                                         glm::vec3 &up) {
+        front = {
+            std::cos(pitch) * std::sin(yaw),
+            std::sin(pitch),
+            std::cos(pitch) * std::cos(yaw)
         };
-        this->leftVector =
-            { std::sin(this->yaw + M_PI_2f32), 0.f, std::cos(this->yaw + M_PI_2f32) };
-        this->upVector = glm::cross(this->frontVector, this->leftVector);
+        left = { std::sin(yaw + M_PI_2f32), 0.f, std::cos(yaw + M_PI_2f32) };
+        up = glm::cross(front, left);
+    }
+    
+    
+    void Camera::computeDirectionVectors() {
+        computeDirectionVectors(this->pitch, this->yaw, this->frontVector, this->leftVector, this->upVector);
     }
     
     
@@ -76,8 +83,19 @@ namespace tool {
     
     
     void Camera::setAngle(GLfloat pitch, GLfloat yaw) {
-        this->pitch = pitch;
+        this->pitch = std::max(std::min(pitch, M_PI_2f32), -M_PI_2f32);
         this->yaw = yaw;
+        computeDirectionVectors();
+    }
+    
+    
+    GLfloat Camera::getPitch() const {
+        return this->pitch;
+    }
+    
+    
+    GLfloat Camera::getYaw() const {
+        return this->yaw;
     }
     
     
@@ -88,8 +106,72 @@ namespace tool {
     }
     
     
+    void Camera::beginTick() {
+        this->previousPosition = this->position;
+        this->previousPitch = this->pitch;
+        this->previousYaw = this->yaw;
+    }
+    
+    
+    void Camera::snap() {
+        this->beginTick();
+        this->interpolate(1.f);
+    }
+    
+    
+    Camera::Pose Camera::getPose() const {
+        return { this->position, this->pitch, this->yaw };
+    }
+    
+    
+    Camera::Pose Camera::getPreviousPose() const {
+        return { this->previousPosition, this->previousPitch, this->previousYaw };
+    }
+    
+    
+    void Camera::setPoses(const Pose &previous, const Pose &current) {
+        this->previousPosition = previous.position;
+        this->previousPitch = previous.pitch;
+        this->previousYaw = previous.yaw;
+        this->position = current.position;
+        this->pitch = current.pitch;
+        this->yaw = current.yaw;
+        computeDirectionVectors();
+    }
+    
+    
+    void Camera::look(GLfloat left, GLfloat up) {
+        this->rotateLeft(left);
+        this->rotateUp(up);
+        this->previousYaw += glm::radians(left);
+        this->previousPitch += glm::radians(up);
+        this->previousPitch = std::max(std::min(this->previousPitch, M_PI_2f32), -M_PI_2f32);
+    }
+    
+    
+    void Camera::interpolate(GLfloat alpha) {
+        GLfloat renderPitch = glm::mix(this->previousPitch, this->pitch, alpha);
+        GLfloat renderYaw = glm::mix(this->previousYaw, this->yaw, alpha);
+        glm::vec3 left, up;
+        
+        this->renderPosition = glm::mix(this->previousPosition, this->position, alpha);
+        computeDirectionVectors(renderPitch, renderYaw, this->renderFront, left, up);
+        this->viewMatrix = glm::lookAt(this->renderPosition, this->renderPosition + this->renderFront, up);
+    }
+    
+    
+    glm::vec3 Camera::getRenderPosition() const {
+        return this->renderPosition;
+    }
+    
+    
+    glm::vec3 Camera::getRenderFrontVector() const {
+        return this->renderFront;
+    }
+    
+    
     glm::mat4 Camera::getViewMatrix() const {
-        return glm::lookAt(this->position, this->position + this->frontVector, this->upVector);
+        return this->viewMatrix;
     }
     
     
@@ -33,7 +33,7 @@ namespace tool {
     
     
     void Input::handleMouseMotion(const SDL_MouseMotionEvent &event) {
-        this->mouseMotion = { event.xrel, event.yrel };
+        this->mouseMotion += glm::vec2(event.xrel, event.yrel);
     }
     
     
@@ -71,13 +71,12 @@ namespace tool {
     
     
     void Input::reset() {
-        for (auto entry: this->buttons) {
+        for (auto &entry: this->buttons) {
             entry.second.reset();
         }
         for (auto &entry: this->keys) {
             entry.second.reset();
         }
-        this->mouseMotion = { 0, 0 };
         this->wheelMotion = { 0, 0 };
     }
     
@@ -174,6 +173,14 @@ namespace tool {
     }
     
     
+    glm::vec2 Input::takeRelativeMotion() {
+        glm::vec2 motion = this->mouseMotion;
+        
+        this->mouseMotion = { 0, 0 };
+        return motion;
+    }
+    
+    
     glm::vec2 Input::getWheelMotion() const {
         return this->wheelMotion;
     }
@@ -0,0 +1,58 @@
+#include <tool/QueryRing.hpp>
+
+
+namespace tool {
+    
+    QueryRing::QueryRing(GLenum t_target, GLuint size) :
+        target(t_target), queries(size), pending(size, false) {
+        glGenQueries(static_cast<GLsizei>(size), this->queries.data());
+    }
+    
+    
+    QueryRing::~QueryRing() {
+        glDeleteQueries(static_cast<GLsizei>(this->queries.size()), this->queries.data());
+    }
+    
+    
+    void QueryRing::begin() {
+        if (this->pending[this->head]) {
+            this->active = false;
+            return;
+        }
+        
+        glBeginQuery(this->target, this->queries[this->head]);
+        this->active = true;
+    }
+    
+    
+    void QueryRing::end() {
+        if (!this->active) {
+            return;
+        }
+        
+        glEndQuery(this->target);
+        this->pending[this->head] = true;
+        this->head = (this->head + 1) % static_cast<GLuint>(this->queries.size());
+        this->active = false;
+    }
+    
+    
+    GLboolean QueryRing::poll(GLuint64 &result) {
+        GLuint available = GL_FALSE;
+        
+        if (!this->pending[this->tail]) {
+            return false;
+        }
+        
+        glGetQueryObjectuiv(this->queries[this->tail], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available != GL_TRUE) {
+            return false;
+        }
+        
+        glGetQueryObjectui64v(this->queries[this->tail], GL_QUERY_RESULT, &result);
+        this->pending[this->tail] = false;
+        this->tail = (this->tail + 1) % static_cast<GLuint>(this->queries.size());
+        
+        return true;
+    }
+}
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <iostream>
 
 #include <SDL.h>
@@ -51,6 +52,15 @@ namespace tool {
     }
     
     
+    Window *Window::headless(const char *title, int32_t width, int32_t height) {
+        if (!std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY")) {
+            setenv("SDL_VIDEODRIVER", "offscreen", 0);
+        }
+        
+        return new Window(title, width, height, SDL_WINDOW_HIDDEN);
+    }
+    
+    
     Window::~Window() {
         SDL_GL_DeleteContext(this->context);
         SDL_DestroyWindow(this->window);
@@ -81,4 +91,13 @@ namespace tool {
         
         return mode;
     }
+    
+    
+    glm::ivec2 Window::getSize() const {
+        glm::ivec2 size;
+        
+        SDL_GL_GetDrawableSize(this->window, &size.x, &size.y);
+        
+        return size;
+    }
 }